@@ -0,0 +1,300 @@
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "arena_resource.h"
+#include "huge_page_allocator.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Tests for the allocator support of sc::vector
+// =============================================================
+
+// Every byte comes from (and goes back to) the allocator.
+#define ALLOC_BALANCED YES
+// The copy ctor asks the allocator what to copy.
+#define ALLOC_COPY_CTRO YES
+// Assignments and swap follow the propagation traits.
+#define ALLOC_PROPAGATION YES
+// Move assignment between unequal allocators moves element by element.
+#define ALLOC_MOVE_UNEQUAL YES
+// malloc_allocator grows relocatable buffers through realloc.
+#define ALLOC_MALLOC YES
+// sc::pmr::vector on an arena, released with a single reset.
+#define ALLOC_PMR_ARENA YES
+// aligned_allocator keeps data() aligned and pads the capacity to whole blocks.
+#define ALLOC_ALIGNED YES
+// huge_page_allocator maps large blocks on 2 MiB aligned huge pages.
+#define ALLOC_HUGE_PAGES YES
+
+namespace {
+/// Bookkeeping shared by every copy of an arena_allocator.
+struct arena_stats {
+  long allocations{0};    //!< Calls to allocate().
+  long live_slots{0};     //!< Slots handed out and not yet returned.
+};
+
+/// Stateful allocator that counts what it hands out.
+/*!
+ * Two instances compare equal only when they share the same stats, so the
+ * propagation traits are meaningful.
+ */
+template <typename T, bool Propagate = false> struct arena_allocator {
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+  using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+  using propagate_on_container_swap = std::bool_constant<Propagate>;
+  template <typename U> struct rebind { using other = arena_allocator<U, Propagate>; };
+
+  arena_stats *stats;
+
+  explicit arena_allocator(arena_stats *s) : stats{s} {}
+  template <typename U>
+  arena_allocator(const arena_allocator<U, Propagate> &other) : stats{other.stats} {}
+
+  T *allocate(std::size_t n) {
+    ++stats->allocations;
+    stats->live_slots += n;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    stats->live_slots -= n;
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  friend bool operator==(const arena_allocator &a, const arena_allocator &b) {
+    return a.stats == b.stats;
+  }
+  friend bool operator!=(const arena_allocator &a, const arena_allocator &b) {
+    return not(a == b);
+  }
+};
+
+/// Allocator whose copies start out with fresh stats (see ALLOC_COPY_CTRO).
+template <typename T> struct fresh_copy_allocator : arena_allocator<T> {
+  using arena_allocator<T>::arena_allocator;
+  template <typename U> struct rebind { using other = fresh_copy_allocator<U>; };
+  static arena_stats copies;
+  fresh_copy_allocator select_on_container_copy_construction() const {
+    return fresh_copy_allocator{&copies};
+  }
+};
+template <typename T> arena_stats fresh_copy_allocator<T>::copies{};
+} // namespace
+
+void run_allocator_tests(void) {
+  TestManager tm{"Allocator testing"};
+
+#if ALLOC_BALANCED
+  {
+    BEGIN_TEST(tm, "AllocBalanced", "vector<string, arena_allocator>");
+    arena_stats stats;
+    {
+      using Alloc = arena_allocator<std::string>;
+      sc::vector<std::string, Alloc> vec{Alloc{&stats}};
+      EXPECT_EQ(stats.allocations, 0);
+      for (int i{0}; i < 100; ++i)
+        vec.push_back(std::to_string(i));
+      vec.insert(vec.begin() + 3, {"a", "b", "c"});
+      vec.erase(vec.begin(), vec.begin() + 10);
+      vec.shrink_to_fit();
+      EXPECT_EQ(stats.live_slots, (long)vec.capacity());
+      EXPECT_EQ(vec.size(), 93u);
+      EXPECT_EQ(vec.front(), "7");
+      EXPECT_TRUE(vec.get_allocator() == Alloc{&stats});
+    }
+    EXPECT_EQ(stats.live_slots, 0);
+  }
+#endif
+
+#if ALLOC_COPY_CTRO
+  {
+    BEGIN_TEST(tm, "AllocCopyCtro", "select_on_container_copy_construction()");
+    arena_stats stats;
+    auto &copies = fresh_copy_allocator<int>::copies;
+    {
+      using Alloc = fresh_copy_allocator<int>;
+      sc::vector<int, Alloc> vec({1, 2, 3}, Alloc{&stats});
+      sc::vector<int, Alloc> copy{vec};
+      EXPECT_EQ(copy, vec);
+      EXPECT_EQ(stats.live_slots, 3);
+      EXPECT_EQ(copies.live_slots, 3);
+      EXPECT_TRUE(copy.get_allocator().stats == &copies);
+
+      // The extended copy ctor takes the allocator as given.
+      sc::vector<int, Alloc> copy2{vec, vec.get_allocator()};
+      EXPECT_EQ(stats.live_slots, 6);
+    }
+    EXPECT_EQ(stats.live_slots, 0);
+    EXPECT_EQ(copies.live_slots, 0);
+  }
+#endif
+
+#if ALLOC_PROPAGATION
+  {
+    BEGIN_TEST(tm, "AllocPropagation", "operator=, swap with POCCA/POCMA/POCS");
+    arena_stats s1, s2;
+    {
+      using Alloc = arena_allocator<int, true>;
+      sc::vector<int, Alloc> a({1, 2, 3}, Alloc{&s1});
+      sc::vector<int, Alloc> b({4, 5}, Alloc{&s2});
+
+      b = a; // b drops its arena and adopts a's.
+      EXPECT_TRUE(b.get_allocator() == a.get_allocator());
+      EXPECT_EQ(s2.live_slots, 0);
+      EXPECT_EQ(b, a);
+
+      sc::vector<int, Alloc> c({7, 8, 9, 10}, Alloc{&s2});
+      a = std::move(c); // Storage and arena change hands.
+      EXPECT_TRUE(a.get_allocator().stats == &s2);
+      EXPECT_EQ(a.size(), 4u);
+      EXPECT_TRUE(c.empty());
+
+      swap(a, b);
+      EXPECT_TRUE(a.get_allocator().stats == &s1);
+      EXPECT_TRUE(b.get_allocator().stats == &s2);
+      EXPECT_EQ(b.back(), 10);
+    }
+    EXPECT_EQ(s1.live_slots, 0);
+    EXPECT_EQ(s2.live_slots, 0);
+  }
+#endif
+
+#if ALLOC_MOVE_UNEQUAL
+  {
+    BEGIN_TEST(tm, "AllocMoveUnequal", "operator=(vector&&) with unequal arenas");
+    arena_stats s1, s2;
+    {
+      using Alloc = arena_allocator<std::string>;
+      static_assert(not std::is_nothrow_move_assignable_v<sc::vector<std::string, Alloc>>);
+      static_assert(std::is_nothrow_move_assignable_v<sc::vector<std::string>>);
+
+      sc::vector<std::string, Alloc> a({"x"}, Alloc{&s1});
+      sc::vector<std::string, Alloc> b({"y", "z"}, Alloc{&s2});
+      a = std::move(b);
+      EXPECT_TRUE(a.get_allocator().stats == &s1);
+      EXPECT_EQ(a.size(), 2u);
+      EXPECT_EQ(a[1], "z");
+      EXPECT_TRUE(b.empty());
+
+      sc::vector<std::string, Alloc> c{std::move(a), Alloc{&s2}};
+      EXPECT_EQ(c.size(), 2u);
+      EXPECT_TRUE(a.empty());
+    }
+    EXPECT_EQ(s1.live_slots, 0);
+    EXPECT_EQ(s2.live_slots, 0);
+  }
+#endif
+
+#if ALLOC_MALLOC
+  {
+    BEGIN_TEST(tm, "AllocMalloc", "vector<int, malloc_allocator<int>>");
+    sc::vector<int, sc::malloc_allocator<int>> vec;
+    for (int i{0}; i < 1000; ++i)
+      vec.push_back(i);
+    vec.reserve(5000);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 1000u);
+    for (auto i{0u}; i < vec.size(); ++i)
+      EXPECT_EQ(vec[i], (int)i);
+    vec = sc::vector<int, sc::malloc_allocator<int>>{};
+    EXPECT_EQ(vec.capacity(), 0u);
+  }
+#endif
+
+#if ALLOC_PMR_ARENA
+  {
+    BEGIN_TEST(tm, "AllocPmrArena", "sc::pmr::vector on arena_resource");
+    sc::pmr::arena_resource<16 * 1024> arena{std::pmr::null_memory_resource()};
+    {
+      sc::pmr::vector<int> ids{&arena};
+      sc::pmr::vector<std::pmr::string> names{&arena};
+      for (int i{0}; i < 100; ++i) {
+        ids.push_back(i);
+        names.emplace_back(1, char('a' + i % 26));
+      }
+      EXPECT_EQ(ids.back(), 99);
+      EXPECT_EQ(names[27], "b");
+      // The strings are built on the arena as well.
+      EXPECT_TRUE(names[0].get_allocator().resource() == &arena);
+      EXPECT_TRUE(ids.get_allocator().resource() == &arena);
+      EXPECT_GE(arena.bytes_used(), 100 * sizeof(int));
+    }
+    arena.reset();
+    EXPECT_EQ(arena.bytes_used(), 0u);
+    sc::pmr::vector<int> again({1, 2, 3}, &arena);
+    EXPECT_EQ(again.size(), 3u);
+  }
+#endif
+
+#if ALLOC_ALIGNED
+  {
+    BEGIN_TEST(tm, "AllocAligned", "sc::aligned_vector<float, 64, true>");
+    auto aligned = [](const void *p, std::size_t a) {
+      return reinterpret_cast<std::uintptr_t>(p) % a == 0;
+    };
+
+    sc::aligned_vector<float, 64, true> vec;
+    for (int i{0}; i < 37; ++i) {
+      vec.push_back(float(i));
+      EXPECT_TRUE(aligned(vec.data(), 64));
+      EXPECT_EQ(vec.capacity() % 16, 0u);
+    }
+    vec.reserve(100);
+    EXPECT_EQ(vec.capacity(), 112u);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 48u);
+    EXPECT_TRUE(aligned(vec.data(), 64));
+    auto copy{vec};
+    EXPECT_TRUE(aligned(copy.data(), 64));
+    EXPECT_EQ(copy.capacity(), 48u);
+    EXPECT_EQ(copy, vec);
+    EXPECT_EQ(copy[36], 36.0f);
+
+    // Page alignment, without padding the capacity.
+    sc::aligned_vector<double, 4096> page(3);
+    EXPECT_TRUE(aligned(page.data(), 4096));
+    EXPECT_EQ(page.capacity(), 3u);
+  }
+#endif
+
+#if ALLOC_HUGE_PAGES
+  {
+    BEGIN_TEST(tm, "AllocHugePages", "vector<uint64_t, huge_page_allocator>");
+    using huge_alloc = sc::huge_page_allocator<std::uint64_t>;
+    constexpr std::size_t huge_page = huge_alloc::huge_page_size;
+
+    sc::vector<std::uint64_t, huge_alloc> vec{huge_alloc{huge_page}};
+    for (std::uint64_t i{0}; i < 1000; ++i)
+      vec.push_back(i);
+    // Below the threshold: regular heap block.
+    EXPECT_EQ(vec.get_allocator().threshold(), huge_page);
+    // Growth past the threshold moves the elements onto huge pages.
+    vec.reserve(huge_page / sizeof(std::uint64_t) + 1);
+#if SC_HAS_HUGE_PAGES
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % huge_page, 0u);
+#endif
+    for (std::uint64_t i{1000}; i < 600'000; ++i)
+      vec.push_back(i);
+    EXPECT_EQ(vec[999], 999u);
+    EXPECT_EQ(vec.back(), 599'999u);
+
+    auto copy{vec};
+    EXPECT_EQ(copy, vec);
+    vec.erase(vec.begin() + 10, vec.end());
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 10u);
+    EXPECT_EQ(vec[9], 9u);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
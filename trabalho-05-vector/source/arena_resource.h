@@ -0,0 +1,80 @@
+#ifndef _ARENA_RESOURCE_H_
+#define _ARENA_RESOURCE_H_
+
+#include <cstddef>         // std::size_t, std::byte, std::max_align_t
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::monotonic_buffer_resource
+
+/// Sequence container namespace.
+namespace sc {
+namespace pmr {
+
+/// Monotonic arena that starts out on an inline buffer.
+/*!
+ * Allocations are carved out of a buffer of `BufferSize` bytes kept inside the
+ * object itself (so an arena declared as a local variable lives on the stack).
+ * When the buffer runs out, further blocks come from the upstream resource,
+ * each one larger than the last. Deallocation is a no-op: the memory is only
+ * given back, all at once, by reset() or by the destructor.
+ *
+ * Typical use is one arena per unit of work, e.g. a request handler:
+ * \code
+ * sc::pmr::arena_resource<64 * 1024> arena;
+ * sc::pmr::vector<int> ids{&arena};
+ * // ... build any number of vectors on `&arena` ...
+ * arena.reset(); // Every vector on the arena must be gone by now.
+ * \endcode
+ *
+ * The arena is not thread safe. That includes the background reclaimer: a
+ * vector on the arena with sc::reclaim::background may leave its storage
+ * to be deallocated later, on another thread, so call
+ * `sc::reclaimer::global().flush()` before the arena is reset or destroyed.
+ *
+ * \tparam BufferSize Size in bytes of the inline buffer.
+ */
+template <std::size_t BufferSize>
+class arena_resource : public std::pmr::memory_resource {
+  static_assert(BufferSize > 0, "the inline buffer must not be empty");
+
+public:
+  /// Creates an arena that spills over to `upstream`.
+  explicit arena_resource(
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : m_monotonic{m_buffer, BufferSize, upstream} {}
+
+  arena_resource(const arena_resource &) = delete;
+  arena_resource &operator=(const arena_resource &) = delete;
+
+  /// Releases every allocation at once and rewinds to the inline buffer.
+  void reset() {
+    m_monotonic.release();
+    m_used = 0;
+  }
+
+  /// Number of bytes handed out since construction or the last reset().
+  std::size_t bytes_used() const { return m_used; }
+
+  /// Size of the inline buffer.
+  static constexpr std::size_t buffer_size() { return BufferSize; }
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void *p = m_monotonic.allocate(bytes, alignment);
+    m_used += bytes;
+    return p;
+  }
+
+  void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  alignas(std::max_align_t) std::byte m_buffer[BufferSize]; //!< Inline storage.
+  std::pmr::monotonic_buffer_resource m_monotonic; //!< Bump allocator over m_buffer.
+  std::size_t m_used{0};                           //!< Bytes handed out.
+};
+
+} // namespace pmr.
+} // namespace sc.
+
+#endif
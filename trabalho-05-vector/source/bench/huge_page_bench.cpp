@@ -0,0 +1,136 @@
+/*!
+ * Random gathers over a large sc::vector<uint64_t>: std::allocator (regular
+ * 4 KiB pages) versus sc::huge_page_allocator (2 MiB transparent huge pages).
+ *
+ * Reports wall time, data TLB read misses (through perf_event_open, when the
+ * kernel lets us) and how much of the process is backed by huge pages.
+ *
+ * Usage: huge_page_bench [buffer size in MiB, default 1024]
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "../huge_page_allocator.h"
+#include "../vector.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr std::size_t n_gathers{20'000'000}; //!< Random loads per run.
+
+/// Counts data TLB read misses of this thread, if perf events are available.
+class dtlb_counter {
+public:
+  dtlb_counter() {
+#if defined(__linux__)
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    m_fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+  ~dtlb_counter() {
+#if defined(__linux__)
+    if (m_fd >= 0) { ::close(m_fd); }
+#endif
+  }
+  dtlb_counter(const dtlb_counter &) = delete;
+  dtlb_counter &operator=(const dtlb_counter &) = delete;
+
+  [[nodiscard]] bool available() const { return m_fd >= 0; }
+
+  void start() {
+#if defined(__linux__)
+    if (!available()) { return; }
+    ::ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+    ::ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  /// Misses since start().
+  long long stop() {
+    long long count{-1};
+#if defined(__linux__)
+    if (!available()) { return count; }
+    ::ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (::read(m_fd, &count, sizeof(count)) != sizeof(count)) { count = -1; }
+#endif
+    return count;
+  }
+
+private:
+  int m_fd{-1};
+};
+
+/// Kilobytes of anonymous memory currently backed by huge pages.
+std::string anon_huge_pages() {
+  std::ifstream smaps{"/proc/self/smaps_rollup"};
+  for (std::string line; std::getline(smaps, line);) {
+    if (line.rfind("AnonHugePages:", 0) == 0) { return line.substr(14); }
+  }
+  return " n/a";
+}
+
+/// Fills a vector of `n` elements and times `n_gathers` random loads from it.
+template <typename Vector> void report(const char *label, Vector vec, std::size_t n) {
+  for (std::size_t i{0}; i < n; ++i)
+    vec.push_back(i * 0x9E3779B97F4A7C15ull);
+
+  dtlb_counter dtlb;
+  std::uint64_t state{0x2545F4914F6CDD1Dull};
+  std::uint64_t checksum{0};
+  dtlb.start();
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t g{0}; g < n_gathers; ++g) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    checksum += vec[state % n];
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const long long misses = dtlb.stop();
+
+  std::cout << label << ": "
+            << std::chrono::duration<double, std::milli>(elapsed).count() << " ms, ";
+  if (misses >= 0) {
+    std::cout << misses << " dTLB read misses, ";
+  } else {
+    std::cout << "dTLB misses n/a, ";
+  }
+  std::cout << "AnonHugePages" << anon_huge_pages() << " (checksum " << checksum
+            << ")\n";
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const std::size_t mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+  const std::size_t n = mib * (std::size_t{1} << 20) / sizeof(std::uint64_t);
+  std::cout << n_gathers << " random gathers over " << mib << " MiB\n";
+
+  {
+    sc::vector<std::uint64_t> vec;
+    vec.reserve(n);
+    report("std::allocator          ", std::move(vec), n);
+  }
+  {
+    sc::vector<std::uint64_t, sc::huge_page_allocator<std::uint64_t>> vec;
+    vec.reserve(n);
+    report("sc::huge_page_allocator ", std::move(vec), n);
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+/*!
+ * Tail latency of push_back(): sc::vector, whose growths move every element
+ * at once, versus sc::incremental_vector, which moves a bounded number of
+ * elements per operation, either releasing the old area inline or handing it
+ * to the background reclaimer.
+ *
+ * Usage: incremental_bench [elements, default 50'000'000]
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "../incremental_vector.h"
+#include "../reclaimer.h"
+#include "../vector.h"
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+/// Appends `n` elements, printing the total time and the slowest push_back().
+template <typename Vector> void report(const char *label, Vector vec, std::size_t n) {
+  clock_type::duration worst{0};
+  std::size_t over_1ms{0};
+  const auto start = clock_type::now();
+  for (std::size_t i{0}; i < n; ++i) {
+    const auto before = clock_type::now();
+    vec.push_back(i);
+    const auto took = clock_type::now() - before;
+    if (took > worst) { worst = took; }
+    if (took > std::chrono::milliseconds{1}) { ++over_1ms; }
+  }
+  const auto elapsed = clock_type::now() - start;
+  std::cout << label << ": total "
+            << std::chrono::duration<double, std::milli>(elapsed).count() << " ms, worst push_back "
+            << std::chrono::duration<double, std::micro>(worst).count() << " us, "
+            << over_1ms << " push_back calls over 1 ms (back " << vec[n - 1] << ")\n";
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+  std::cout << n << " push_back calls of std::uint64_t\n";
+
+  report("sc::vector            ", sc::vector<std::uint64_t>{}, n);
+  report("sc::incremental_vector", sc::incremental_vector<std::uint64_t>{}, n);
+  report("  + background reclaim",
+         sc::incremental_vector<std::uint64_t, std::allocator<std::uint64_t>, sc::growth::doubling,
+                                sc::reclaim::background<>>{},
+         n);
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*!
+ * Heap traffic of per-request temporary vectors: sc::vector on the global
+ * heap versus sc::pmr::vector on an arena that is reset after each request.
+ *
+ * Every call to the global operator new is counted, which covers
+ * std::allocator and the arena's upstream resource alike.
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "../arena_resource.h"
+#include "../vector.h"
+
+namespace {
+std::size_t heap_allocations{0}; //!< Calls to the global operator new.
+
+constexpr int n_requests{20'000};       //!< Simulated requests.
+constexpr int vectors_per_request{32};  //!< Temporaries built by each request.
+
+/// Work done by one request: build a few vectors, combine them, drop them.
+template <typename MakeVector> long handle_request(int seed, MakeVector make) {
+  long checksum{0};
+  for (int v{0}; v < vectors_per_request; ++v) {
+    auto vec = make();
+    const int n = 8 + (seed * 31 + v * 17) % 120;
+    for (int i{0}; i < n; ++i)
+      vec.push_back(i ^ seed);
+    for (auto x : vec)
+      checksum += x;
+  }
+  return checksum;
+}
+
+/// Runs every request, printing heap allocations and wall time.
+template <typename Run> void report(const char *label, Run run) {
+  const auto allocations_before = heap_allocations;
+  const auto start = std::chrono::steady_clock::now();
+  long checksum = run();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << label << ": " << (heap_allocations - allocations_before)
+            << " heap allocations, "
+            << std::chrono::duration<double, std::milli>(elapsed).count()
+            << " ms (checksum " << checksum << ")\n";
+}
+} // namespace
+
+void *operator new(std::size_t size) {
+  ++heap_allocations;
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+  std::cout << n_requests << " requests x " << vectors_per_request
+            << " temporary vectors each\n";
+
+  report("sc::vector<int>          ", [] {
+    long checksum{0};
+    for (int r{0}; r < n_requests; ++r)
+      checksum += handle_request(r, [] { return sc::vector<int>{}; });
+    return checksum;
+  });
+
+  report("sc::pmr::vector<int>+arena", [] {
+    long checksum{0};
+    sc::pmr::arena_resource<64 * 1024> arena;
+    for (int r{0}; r < n_requests; ++r) {
+      checksum += handle_request(r, [&arena] { return sc::pmr::vector<int>{&arena}; });
+      arena.reset();
+    }
+    return checksum;
+  });
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+/*!
+ * sc::simd kernels versus the scalar loops they replace, which walk the
+ * vector through its iterators with the standard algorithms.
+ *
+ * Prints one row per kernel and element type with the best time of a few
+ * runs. Build with optimizations (e.g. -DCMAKE_BUILD_TYPE=Release) for
+ * meaningful numbers.
+ *
+ * Usage: simd_bench [elements, default 4'000'000]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+
+#include "../simd.h"
+#include "../vector.h"
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+constexpr int runs{7}; //!< Each kernel keeps its best run.
+
+/// Keeps `value` alive so the timed work is not optimized away.
+template <typename V> void keep(const V &value) { asm volatile("" : : "g"(&value) : "memory"); }
+
+/// Best time, in milliseconds, of running `work`.
+template <typename Work> double best_ms(Work work) {
+  double best{1e300};
+  for (int r{0}; r < runs; ++r) {
+    const auto start = clock_type::now();
+    keep(work());
+    best = std::min(best, std::chrono::duration<double, std::milli>(clock_type::now() - start).count());
+  }
+  return best;
+}
+
+void row(const char *kernel, const char *type, double scalar, double simd) {
+  std::printf("| %-10s | %-7s | %10.3f | %10.3f | %7.2fx |\n", kernel, type, scalar, simd, scalar / simd);
+}
+
+template <typename T> void bench_type(const char *type, std::size_t n) {
+  sc::vector<T> a(n), b(n);
+  for (std::size_t i{0}; i < n; ++i) {
+    a[i] = T((i * 7919) % 1000);
+    b[i] = T((i * 104729) % 1000);
+  }
+  const T missing = T(-1); // Forces a full scan.
+
+  row("find", type, best_ms([&] { return std::find(a.begin(), a.end(), missing) - a.begin(); }),
+      best_ms([&] { return sc::simd::find_first(a, missing); }));
+  row("count", type, best_ms([&] { return std::count(a.begin(), a.end(), T(7)); }),
+      best_ms([&] { return sc::simd::count(a, T(7)); }));
+  row("min", type, best_ms([&] { return *std::min_element(a.begin(), a.end()); }),
+      best_ms([&] { return sc::simd::min(a); }));
+  row("max", type, best_ms([&] { return *std::max_element(a.begin(), a.end()); }),
+      best_ms([&] { return sc::simd::max(a); }));
+  row("argmin", type, best_ms([&] { return std::min_element(a.begin(), a.end()) - a.begin(); }),
+      best_ms([&] { return sc::simd::argmin(a); }));
+  row("sum", type, best_ms([&] { return std::accumulate(a.begin(), a.end(), sc::simd::sum_t<T>{}); }),
+      best_ms([&] { return sc::simd::sum(a); }));
+  row("dot", type,
+      best_ms([&] { return std::inner_product(a.begin(), a.end(), b.begin(), sc::simd::sum_t<T>{}); }),
+      best_ms([&] { return sc::simd::dot(a, b); }));
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+  std::printf("%zu elements, best of %d runs (multiversioned kernels: %s)\n\n", n, runs,
+              SC_HAS_SIMD_CLONES ? "yes" : "no");
+  std::printf("| kernel     | type    | scalar ms  |  simd ms   | speedup  |\n");
+  std::printf("|------------|---------|------------|------------|----------|\n");
+  bench_type<std::int32_t>("int32", n);
+  bench_type<float>("float", n);
+  bench_type<double>("double", n);
+  return 0;
+}
@@ -0,0 +1,225 @@
+#include "bulk.h"
+
+#include <algorithm> // std::min, std::max
+#include <atomic>    // std::atomic
+#include <cstdint>   // std::uintptr_t
+
+#if SC_HAS_BULK_KERNELS
+#include <cpuid.h>     // __get_cpuid_max, __get_cpuid_count
+#include <immintrin.h> // _mm_stream_si128, _mm256_stream_si256, _mm512_stream_si512
+#endif
+
+namespace sc::bulk {
+
+namespace {
+
+using detail::step;
+
+/// Size in bytes of the largest data or unified cache reported by cpuid, or 0.
+std::size_t cpuid_last_level_cache() {
+#if SC_HAS_BULK_KERNELS
+  // Leaf 4 on Intel, 0x8000001D on AMD; both describe one cache per subleaf.
+  std::size_t largest{0};
+  for (unsigned leaf : {4u, 0x8000001Du}) {
+    if (__get_cpuid_max(leaf & 0x80000000u, nullptr) < leaf) { continue; }
+    for (unsigned sub{0}; sub < 16; ++sub) {
+      unsigned eax, ebx, ecx, edx;
+      if (!__get_cpuid_count(leaf, sub, &eax, &ebx, &ecx, &edx) || (eax & 0x1Fu) == 0) { break; }
+      if ((eax & 0x1Fu) == 2) { continue; } // Instruction cache.
+      const std::size_t ways = (ebx >> 22) + 1;
+      const std::size_t partitions = ((ebx >> 12) & 0x3FFu) + 1;
+      const std::size_t line = (ebx & 0xFFFu) + 1;
+      const std::size_t sets = std::size_t{ecx} + 1;
+      largest = std::max(largest, ways * partitions * line * sets);
+    }
+    if (largest != 0) { break; }
+  }
+  return largest;
+#else
+  return 0;
+#endif
+}
+
+/// Threshold of non-temporal stores; starts at the last level cache size.
+std::atomic<std::size_t> &threshold() {
+  static std::atomic<std::size_t> bytes{[] {
+    const std::size_t llc = cpuid_last_level_cache();
+    return llc != 0 ? llc : std::size_t{32} << 20;
+  }()};
+  return bytes;
+}
+
+/// Bytes from `p` up to the next `step` boundary.
+std::size_t head_bytes(const void *p) {
+  return (step - reinterpret_cast<std::uintptr_t>(p) % step) % step;
+}
+
+/*!
+ * One kernel set. `copy` writes `bytes` bytes from `src` to `dst` (which do
+ * not overlap) with non-temporal stores. `fill` writes `bytes` bytes of
+ * `pattern`, a buffer of 2 * `step` bytes that repeats the element, with
+ * non-temporal stores if `stream` is set.
+ */
+struct kernels {
+  void (*copy)(void *dst, const void *src, std::size_t bytes);
+  void (*fill)(void *dst, std::size_t bytes, const unsigned char *pattern, std::size_t elem_size,
+               bool stream);
+  const char *name;
+};
+
+/*!
+ * Kernel bodies, shared by the instruction sets. `Ops` provides `block`
+ * (what one `step` of bytes is kept in), `load`, `store`, `stream` and
+ * `fence`. The unaligned head and the tail are copied with memcpy, so the
+ * loop only runs over `step`-aligned destinations.
+ */
+#define SC_BULK_KERNELS(Ops, Target)                                                              \
+  Target void copy_##Ops(void *dst, const void *src, std::size_t bytes) {                         \
+    auto *out = static_cast<unsigned char *>(dst);                                                \
+    const auto *in = static_cast<const unsigned char *>(src);                                     \
+    const std::size_t head = std::min(head_bytes(out), bytes);                                    \
+    std::memcpy(out, in, head);                                                                   \
+    std::size_t done = head;                                                                      \
+    for (; done + step <= bytes; done += step)                                                    \
+      Ops::stream(out + done, Ops::load(in + done));                                              \
+    Ops::fence();                                                                                 \
+    std::memcpy(out + done, in + done, bytes - done);                                             \
+  }                                                                                               \
+  Target void fill_##Ops(void *dst, std::size_t bytes, const unsigned char *pattern,              \
+                         std::size_t elem_size, bool stream) {                                    \
+    auto *out = static_cast<unsigned char *>(dst);                                                \
+    const std::size_t head = std::min(head_bytes(out), bytes);                                    \
+    std::memcpy(out, pattern, head);                                                              \
+    /* Every step starts at the same offset within an element. */                                 \
+    const unsigned char *phase = pattern + head % elem_size;                                      \
+    const typename Ops::block value = Ops::load(phase);                                           \
+    std::size_t done = head;                                                                      \
+    if (stream) {                                                                                 \
+      for (; done + step <= bytes; done += step)                                                  \
+        Ops::stream(out + done, value);                                                           \
+      Ops::fence();                                                                               \
+    } else {                                                                                      \
+      for (; done + step <= bytes; done += step)                                                  \
+        Ops::store(out + done, value);                                                            \
+    }                                                                                             \
+    std::memcpy(out + done, phase, bytes - done);                                                 \
+  }
+
+#if SC_HAS_BULK_KERNELS
+
+struct sse2 {
+  struct block { __m128i v[4]; };
+  static block load(const unsigned char *p) {
+    block b;
+    for (int i{0}; i < 4; ++i)
+      b.v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p) + i);
+    return b;
+  }
+  static void store(unsigned char *p, const block &b) {
+    for (int i{0}; i < 4; ++i)
+      _mm_store_si128(reinterpret_cast<__m128i *>(p) + i, b.v[i]);
+  }
+  static void stream(unsigned char *p, const block &b) {
+    for (int i{0}; i < 4; ++i)
+      _mm_stream_si128(reinterpret_cast<__m128i *>(p) + i, b.v[i]);
+  }
+  static void fence() { _mm_sfence(); }
+};
+
+struct avx2 {
+  struct block { __m256i v[2]; };
+  __attribute__((target("avx2"))) static block load(const unsigned char *p) {
+    return {{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)),
+             _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p) + 1)}};
+  }
+  __attribute__((target("avx2"))) static void store(unsigned char *p, const block &b) {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), b.v[0]);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p) + 1, b.v[1]);
+  }
+  __attribute__((target("avx2"))) static void stream(unsigned char *p, const block &b) {
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(p), b.v[0]);
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(p) + 1, b.v[1]);
+  }
+  static void fence() { _mm_sfence(); }
+};
+
+struct avx512 {
+  struct block { __m512i v; };
+  __attribute__((target("avx512f"))) static block load(const unsigned char *p) {
+    return {_mm512_loadu_si512(p)};
+  }
+  __attribute__((target("avx512f"))) static void store(unsigned char *p, const block &b) {
+    _mm512_store_si512(p, b.v);
+  }
+  __attribute__((target("avx512f"))) static void stream(unsigned char *p, const block &b) {
+    _mm512_stream_si512(reinterpret_cast<__m512i *>(p), b.v);
+  }
+  static void fence() { _mm_sfence(); }
+};
+
+SC_BULK_KERNELS(sse2, )
+SC_BULK_KERNELS(avx2, __attribute__((target("avx2"))))
+SC_BULK_KERNELS(avx512, __attribute__((target("avx512f"))))
+
+/// The best kernel set for the running CPU.
+kernels select() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) { return {copy_avx512, fill_avx512, "avx512f"}; }
+  if (__builtin_cpu_supports("avx2")) { return {copy_avx2, fill_avx2, "avx2"}; }
+  return {copy_sse2, fill_sse2, "sse2"};
+}
+
+#else
+
+/// Without SIMD kernels the copies go to memcpy and fills to plain loops.
+struct generic {
+  struct block { unsigned char v[step]; };
+  static block load(const unsigned char *p) {
+    block b;
+    std::memcpy(b.v, p, step);
+    return b;
+  }
+  static void store(unsigned char *p, const block &b) { std::memcpy(p, b.v, step); }
+  static void stream(unsigned char *p, const block &b) { std::memcpy(p, b.v, step); }
+  static void fence() {}
+};
+
+SC_BULK_KERNELS(generic, )
+
+kernels select() { return {copy_generic, fill_generic, "generic"}; }
+
+#endif
+
+#undef SC_BULK_KERNELS
+
+/// Kernel set picked on first use.
+const kernels &active() {
+  static const kernels selected = select();
+  return selected;
+}
+
+} // namespace
+
+void detail::stream_copy(void *dst, const void *src, std::size_t bytes) {
+  active().copy(dst, src, bytes);
+}
+
+void detail::fill_pattern(void *dst, std::size_t bytes, const unsigned char *pattern,
+                          std::size_t elem_size, bool stream) {
+  active().fill(dst, bytes, pattern, elem_size, stream);
+}
+
+const char *isa() { return active().name; }
+
+std::size_t last_level_cache_size() {
+  static const std::size_t bytes = cpuid_last_level_cache();
+  return bytes;
+}
+
+std::size_t non_temporal_threshold() { return threshold().load(std::memory_order_relaxed); }
+
+void set_non_temporal_threshold(std::size_t bytes) {
+  threshold().store(bytes, std::memory_order_relaxed);
+}
+
+} // namespace sc::bulk.
@@ -0,0 +1,106 @@
+#ifndef _BULK_H_
+#define _BULK_H_
+
+#include <cstddef>     // std::size_t
+#include <cstring>     // std::memcpy
+#include <type_traits> // std::is_trivially_copyable_v
+
+/// Whether bulk.cpp has SIMD kernels for this target (x86-64).
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SC_HAS_BULK_KERNELS 1
+#else
+#define SC_HAS_BULK_KERNELS 0
+#endif
+
+/// Sequence container namespace.
+namespace sc {
+
+/*!
+ * Bulk copy and fill of trivially copyable elements, as used by sc::vector
+ * for copies, relocations and value fills.
+ *
+ * On x86-64 the kernels come in SSE2, AVX2 and AVX-512 flavours; the best one
+ * the CPU supports is picked, through cpuid, the first time it is needed and
+ * then used for the rest of the run. They live in bulk.cpp, so this header
+ * pulls in no intrinsics.
+ *
+ * Blocks of at least non_temporal_threshold() bytes (by default the size of
+ * the last level cache) are written with non-temporal stores, which bypass
+ * the caches: copying a multi-GB vector then no longer evicts the working
+ * set of the program, and the destination is not read before it is written.
+ * Smaller copies go to `std::memcpy`, which is already tuned for data that
+ * fits in the cache, so the copy kernels only ever run as non-temporal
+ * ones. Smaller fills of a few blocks or more still go through the kernels,
+ * with regular stores, since `std::memset` only repeats single bytes.
+ */
+namespace bulk {
+
+namespace detail {
+
+/// Bytes written per loop step by every kernel.
+constexpr std::size_t step = 64;
+
+/// Element types that fill() writes through the kernels.
+template <typename T>
+inline constexpr bool is_fillable_v = std::is_trivially_copyable_v<T> && sizeof(T) <= step &&
+                                      step % sizeof(T) == 0;
+
+/// Copies `bytes` bytes from `src` to `dst`, which do not overlap, with non-temporal stores.
+void stream_copy(void *dst, const void *src, std::size_t bytes);
+
+/*!
+ * Writes `bytes` bytes of `pattern`, a buffer of 2 * `step` bytes that
+ * repeats an element of `elem_size` bytes, to `dst`; with non-temporal
+ * stores if `stream` is set.
+ */
+void fill_pattern(void *dst, std::size_t bytes, const unsigned char *pattern, std::size_t elem_size,
+                  bool stream);
+
+} // namespace detail
+
+/// Name of the kernel set in use: "avx512f", "avx2", "sse2" or "generic".
+const char *isa();
+
+/// Size in bytes of the last level cache as reported by cpuid, or 0 if unknown.
+std::size_t last_level_cache_size();
+
+/// Size from which copies and fills use non-temporal stores.
+std::size_t non_temporal_threshold();
+
+/// Changes non_temporal_threshold(), e.g. to tune it per machine.
+void set_non_temporal_threshold(std::size_t bytes);
+
+/// Copies `bytes` bytes from `src` to `dst`, which must not overlap.
+inline void copy(void *dst, const void *src, std::size_t bytes) {
+  if (bytes == 0) { return; }
+  if (bytes < non_temporal_threshold()) {
+    std::memcpy(dst, src, bytes);
+  } else {
+    detail::stream_copy(dst, src, bytes);
+  }
+}
+
+/// Writes `n` copies of `value` to `dst` (raw memory or live elements).
+template <typename T>
+void fill(T *dst, std::size_t n, const T &value) {
+  static_assert(std::is_trivially_copyable_v<T>, "bulk::fill needs trivially copyable elements");
+  const std::size_t bytes = n * sizeof(T);
+  if constexpr (detail::is_fillable_v<T>) {
+    // Short runs are not worth building the pattern for.
+    if (bytes >= 4 * detail::step) {
+      unsigned char pattern[2 * detail::step];
+      for (std::size_t i{0}; i < sizeof pattern; i += sizeof(T))
+        std::memcpy(pattern + i, &value, sizeof(T));
+      detail::fill_pattern(dst, bytes, pattern, sizeof(T), bytes >= non_temporal_threshold());
+      return;
+    }
+  }
+  for (std::size_t i{0}; i < n; ++i)
+    std::memcpy(static_cast<void *>(dst + i), &value, sizeof(T));
+}
+
+} // namespace bulk.
+
+} // namespace sc.
+
+#endif
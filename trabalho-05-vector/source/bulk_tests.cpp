@@ -0,0 +1,173 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include "bulk.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Tests for the bulk copy and fill kernels
+// =============================================================
+
+// A kernel set is picked and the threshold starts at the cache size.
+#define BULK_DISPATCH YES
+// copy() at every alignment, with and without non-temporal stores.
+#define BULK_COPY YES
+// fill() with elements of 1 to 64 bytes at every alignment.
+#define BULK_FILL YES
+// sc::vector copies, reallocations and fills over the streaming kernels.
+#define BULK_VECTOR YES
+
+namespace {
+/// Element of 16 bytes, trivially copyable.
+struct Pair {
+  std::int64_t a, b;
+  bool operator==(const Pair &rhs) const { return a == rhs.a and b == rhs.b; }
+  bool operator!=(const Pair &rhs) const { return not(*this == rhs); }
+};
+
+/// Element of 12 bytes, which does not tile the kernel step.
+struct Triple {
+  std::int32_t x, y, z;
+  bool operator==(const Triple &rhs) const { return x == rhs.x and y == rhs.y and z == rhs.z; }
+  bool operator!=(const Triple &rhs) const { return not(*this == rhs); }
+};
+
+/// Runs `work` with every copy and fill going through the streaming kernels.
+template <typename Work> void streaming(Work work) {
+  const std::size_t saved = sc::bulk::non_temporal_threshold();
+  sc::bulk::set_non_temporal_threshold(0);
+  work();
+  sc::bulk::set_non_temporal_threshold(saved);
+}
+
+/// Fills `n` elements at `offset` elements into a buffer and checks them and their surroundings.
+template <typename T> bool fill_matches(std::size_t offset, std::size_t n, const T &value, const T &guard) {
+  T buffer[300];
+  for (auto &x : buffer)
+    x = guard;
+  sc::bulk::fill(buffer + offset, n, value);
+  for (std::size_t i{0}; i < 300; ++i) {
+    const bool inside = i >= offset && i < offset + n;
+    if (std::memcmp(&buffer[i], inside ? &value : &guard, sizeof(T)) != 0) { return false; }
+  }
+  return true;
+}
+} // namespace
+
+void run_bulk_tests(void) {
+  TestManager tm{"Bulk kernel testing"};
+
+#if BULK_DISPATCH
+  {
+    BEGIN_TEST(tm, "BulkDispatch", "isa(), last_level_cache_size(), non_temporal_threshold()");
+    const char *isa = sc::bulk::isa();
+    EXPECT_TRUE(isa != nullptr);
+    EXPECT_TRUE(isa == sc::bulk::isa()); // Picked once.
+#if SC_HAS_BULK_KERNELS
+    EXPECT_GE(sc::bulk::last_level_cache_size(), std::size_t{64} << 10);
+    EXPECT_EQ(sc::bulk::non_temporal_threshold(), sc::bulk::last_level_cache_size());
+#endif
+    sc::bulk::set_non_temporal_threshold(12345);
+    EXPECT_EQ(sc::bulk::non_temporal_threshold(), 12345u);
+    sc::bulk::set_non_temporal_threshold(sc::bulk::last_level_cache_size());
+  }
+#endif
+
+#if BULK_COPY
+  {
+    BEGIN_TEST(tm, "BulkCopy", "copy() with misaligned source, destination and size");
+    unsigned char src[1200], dst[1200];
+    for (std::size_t i{0}; i < sizeof src; ++i)
+      src[i] = static_cast<unsigned char>(i * 31 + 7);
+    bool all_equal{true};
+    streaming([&] {
+      for (std::size_t from{0}; from < 64; from += 7) {
+        for (std::size_t to{0}; to < 64; to += 5) {
+          for (std::size_t bytes : {0u, 1u, 63u, 64u, 65u, 200u, 1000u}) {
+            std::memset(dst, 0xEE, sizeof dst);
+            sc::bulk::copy(dst + to, src + from, bytes);
+            all_equal = all_equal && std::memcmp(dst + to, src + from, bytes) == 0;
+            all_equal = all_equal && (to == 0 || dst[to - 1] == 0xEE) && dst[to + bytes] == 0xEE;
+          }
+        }
+      }
+    });
+    EXPECT_TRUE(all_equal);
+    sc::bulk::copy(dst, src, 100); // Below the threshold: plain memcpy.
+    EXPECT_EQ(std::memcmp(dst, src, 100), 0);
+  }
+#endif
+
+#if BULK_FILL
+  {
+    BEGIN_TEST(tm, "BulkFill", "fill() of char, int16, int32, double, Pair and Triple");
+    for (bool stream : {false, true}) {
+      auto check = [&] {
+        for (std::size_t offset : {0u, 1u, 3u, 5u, 17u}) {
+          for (std::size_t n : {0u, 1u, 40u, 100u, 250u}) {
+            EXPECT_TRUE(fill_matches<char>(offset, n, 'x', '.'));
+            EXPECT_TRUE(fill_matches<std::int16_t>(offset, n, 0x1234, -1));
+            EXPECT_TRUE(fill_matches<std::int32_t>(offset, n, 0x12345678, -1));
+            EXPECT_TRUE(fill_matches<double>(offset, n, 2.5, -1.0));
+            EXPECT_TRUE(fill_matches<Pair>(offset, n, Pair{1, 2}, Pair{-1, -1}));
+            EXPECT_TRUE(fill_matches<Triple>(offset, n, Triple{1, 2, 3}, Triple{0, 0, 0}));
+          }
+        }
+      };
+      if (stream) {
+        streaming(check);
+      } else {
+        check();
+      }
+    }
+  }
+#endif
+
+#if BULK_VECTOR
+  {
+    BEGIN_TEST(tm, "BulkVector", "copy ctor, reserve(), assign(), resize() while streaming");
+    streaming([&] {
+      sc::vector<std::int32_t> vec;
+      for (std::int32_t i{0}; i < 10'000; ++i)
+        vec.push_back(i);
+      sc::vector<std::int32_t> copy{vec};
+      EXPECT_EQ(copy, vec);
+      copy.reserve(50'001);
+      EXPECT_EQ(copy, vec);
+      copy.resize(20'000);
+      EXPECT_EQ(copy[9'999], 9'999);
+      EXPECT_EQ(copy[10'000], 0);
+      EXPECT_EQ(copy[19'999], 0);
+      copy.resize(30'000, 7);
+      EXPECT_EQ(copy[20'000], 7);
+      EXPECT_EQ(copy[29'999], 7);
+      copy.assign(std::size_t{25'000}, copy[20'000]); // `value` aliases an element.
+      EXPECT_EQ(copy.size(), 25'000u);
+      EXPECT_EQ(sc::erase(copy, 7), 25'000u);
+
+      sc::vector<Pair> pairs;
+      pairs.assign(1000, Pair{3, 4});
+      pairs.assign(999, Pair{5, 6});
+      EXPECT_EQ(pairs.size(), 999u);
+      EXPECT_TRUE(pairs[0] == (Pair{5, 6}));
+      EXPECT_TRUE(pairs[998] == (Pair{5, 6}));
+
+      // Empty ranges never dereference their iterators.
+      const sc::vector<std::int32_t> none;
+      sc::vector<std::int32_t> from_none(none.begin(), none.end());
+      EXPECT_TRUE(from_none.empty());
+      copy.assign(none.begin(), none.end());
+      EXPECT_TRUE(copy.empty());
+    });
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
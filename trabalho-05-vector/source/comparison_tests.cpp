@@ -0,0 +1,100 @@
+#include <compare>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "test_types.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+using sc_test::Tracked;
+
+// =============================================================
+// Tests for the comparison operators of sc::vector
+// =============================================================
+
+// ==, != and <=> agree with the element-wise definitions on every path.
+#define COMPARE_VECTORIZED YES
+
+namespace {
+/// Enumeration whose `==` treats `wild` as equal to anything.
+enum class Suit { hearts, spades, wild };
+bool operator==(Suit a, Suit b) {
+  const int x = static_cast<int>(a), y = static_cast<int>(b), wild = static_cast<int>(Suit::wild);
+  return x == wild || y == wild || x == y;
+}
+bool operator!=(Suit a, Suit b) { return not(a == b); }
+} // namespace
+
+void run_comparison_tests(void) {
+  TestManager tm{"Comparison testing"};
+
+#if COMPARE_VECTORIZED
+  {
+    BEGIN_TEST(tm, "CompareVectorized", "==, <=> on int, char, double, enums and std::string");
+    // Move a single mismatch across block boundaries and the scalar tail.
+    sc::vector<int> base(203);
+    for (auto i{0u}; i < base.size(); ++i)
+      base[i] = int(i) - 100;
+    for (std::size_t at : {0u, 3u, 4u, 7u, 8u, 31u, 32u, 100u, 199u, 202u}) {
+      sc::vector<int> other{base};
+      EXPECT_TRUE(other == base);
+      EXPECT_TRUE((other <=> base) == 0);
+      other[at] += 1;
+      EXPECT_FALSE(other == base);
+      EXPECT_TRUE(other != base);
+      EXPECT_TRUE(base < other);
+      other[at] -= 2;
+      EXPECT_TRUE(other < base);
+      EXPECT_TRUE((base <=> other) == std::strong_ordering::greater);
+    }
+    sc::vector<int> prefix{base.begin(), base.begin() + 150};
+    EXPECT_TRUE(prefix < base);
+    EXPECT_TRUE(base > prefix);
+    EXPECT_TRUE(sc::vector<int>{} < prefix);
+
+    // Bytes compare as the element type, not as unsigned char.
+    sc::vector<signed char> low, high;
+    low.resize(40, 1);
+    high.resize(40, 1);
+    low[33] = -1;
+    EXPECT_TRUE(low < high);
+
+    sc::vector<double> x, y;
+    x.resize(37, 1.5);
+    y.resize(37, 1.5);
+    x[35] = 0.0;
+    y[35] = -0.0;
+    EXPECT_TRUE(x == y);
+    y[36] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_FALSE(x == y);
+    EXPECT_TRUE((x <=> y) == std::partial_ordering::unordered);
+    EXPECT_FALSE(y == y);
+
+    sc::vector<std::string> words{"apple", "pear"}, more{"apple", "plum"};
+    EXPECT_TRUE(words < more);
+    EXPECT_TRUE((words <=> words) == 0);
+
+    // Types with only `<` get a weak ordering.
+    sc::vector<Tracked> small{Tracked{1}, Tracked{2}}, big{Tracked{1}, Tracked{3}};
+    EXPECT_TRUE(small < big);
+    EXPECT_TRUE((big <=> small) == std::weak_ordering::greater);
+
+    // An enumeration is compared through its own `==`, not bytewise.
+    sc::vector<Suit> hand, wild;
+    hand.resize(40, Suit::hearts);
+    wild.resize(40, Suit::hearts);
+    wild[37] = Suit::wild;
+    EXPECT_TRUE(hand == wild);
+    wild[38] = Suit::spades;
+    EXPECT_FALSE(hand == wild);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,739 @@
+#ifndef _DEVECTOR_H_
+#define _DEVECTOR_H_
+
+#include "vector.h" // sc::MyForwardIterator, sc::growth, sc::is_trivially_relocatable
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Double-ended vector: contiguous storage with spare room at both ends.
+/*!
+ * sc::devector offers the interface of sc::vector, but its elements sit in
+ * the middle of the storage area, with free slots before and after them.
+ * push_front()/pop_front() are therefore as cheap as push_back()/pop_back():
+ * amortized O(1), instead of shifting every element. The elements are still
+ * contiguous, so data() and pointer arithmetic keep working.
+ *
+ *     [ raw ... raw | e0 e1 ... e(n-1) | raw ... raw ]
+ *       front gap     m_front   m_back   back gap
+ *
+ * When an end runs out of room the elements are re-centered, either in place
+ * (if at most half of the storage is in use) or in a bigger area chosen by
+ * the growth policy, so both gaps get an even share of the free slots.
+ * Insertions and erasures in the middle shift whichever side is shorter.
+ *
+ * \tparam T The type of the elements.
+ * \tparam Allocator The allocator used to acquire the storage area.
+ * \tparam GrowthPolicy How the capacity grows (see sc::growth).
+ */
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = growth::doubling>
+class devector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Allocator::value_type must be the same as T");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T *>,
+                "sc::devector requires an allocator with raw pointers");
+
+  //=== Aliases
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using const_pointer = const value_type *; //!< Pointer to a const value.
+  using reference = value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value stored in the container.
+  using iterator = MyForwardIterator<value_type>; //!< The iterator.
+  using const_iterator = MyForwardIterator<const value_type>; //!< The const_iterator.
+  using allocator_type = Allocator;   //!< The allocator type.
+  using growth_policy = GrowthPolicy; //!< The capacity growth policy.
+
+  //=== [I] SPECIAL MEMBERS
+/**
+ * @brief Constructs an empty devector, without allocating any memory.
+ */
+devector() : devector(Allocator()) {}
+
+/**
+ * @brief Constructs an empty devector that will allocate from `alloc`.
+ *
+ * @param alloc The allocator to use.
+ */
+explicit devector(const Allocator &alloc) noexcept
+  : m_front{0}, m_back{0}, m_capacity{0}, m_buffer{nullptr}, m_alloc{alloc} {}
+
+/**
+ * @brief Constructs a devector with `count` value-initialized elements.
+ *
+ * @param count The initial size (and capacity).
+ * @param alloc The allocator to use.
+ */
+explicit devector(size_type count, const Allocator &alloc = Allocator())
+  : devector(alloc) {
+  m_buffer = allocate(count);
+  m_capacity = count;
+  construct_n(m_buffer, count);
+  m_back = count;
+}
+
+/**
+ * @brief Constructs a devector with the elements of an initializer list.
+ *
+ * @param il The initializer list.
+ * @param alloc The allocator to use.
+ */
+devector(const std::initializer_list<T> &il, const Allocator &alloc = Allocator())
+  : devector(il.begin(), il.end(), alloc) {}
+
+/**
+ * @brief Constructs a devector from the range [first, last).
+ *
+ * @param first Iterator to the beginning of the range.
+ * @param last Iterator to the end of the range.
+ * @param alloc The allocator to use.
+ */
+template <typename InputItr>
+devector(InputItr first, InputItr last, const Allocator &alloc = Allocator())
+  : devector(alloc) {
+  const size_type count = std::distance(first, last);
+  m_buffer = allocate(count);
+  m_capacity = count;
+  construct_copies(first, count, m_buffer);
+  m_back = count;
+}
+
+/**
+ * @brief Copy constructor; the copy keeps the same capacity and gaps.
+ *
+ * @param other The devector to copy from.
+ */
+devector(const devector &other)
+  : devector(alloc_traits::select_on_container_copy_construction(other.m_alloc)) {
+  m_buffer = allocate(other.m_capacity);
+  m_capacity = other.m_capacity;
+  construct_copies(other.m_buffer + other.m_front, other.size(), m_buffer + other.m_front);
+  m_front = other.m_front;
+  m_back = other.m_back;
+}
+
+/**
+ * @brief Move constructor: takes over the storage of `other` in O(1).
+ *
+ * @param other The devector to move from.
+ */
+devector(devector &&other) noexcept
+  : devector(std::move(other.m_alloc)) {
+  steal(other);
+}
+
+/**
+ * @brief Destructor.
+ */
+~devector() { release(); }
+
+/**
+ * @brief Copy assignment operator.
+ *
+ * @param rhs The devector to copy from.
+ * @return Reference to the modified devector.
+ */
+devector &operator=(const devector &rhs) {
+  if (this == &rhs) { return *this; }
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+    if (m_alloc != rhs.m_alloc) { release(); }
+    m_alloc = rhs.m_alloc;
+  }
+  assign_n(rhs.m_buffer + rhs.m_front, rhs.size());
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ *
+ * Takes over the storage of `rhs` when our allocator can release it;
+ * otherwise the elements are moved one by one. `rhs` is left empty.
+ *
+ * @param rhs The devector to move from.
+ * @return Reference to the modified devector.
+ */
+devector &operator=(devector &&rhs) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value) {
+  if (this == &rhs) { return *this; }
+  if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+    release();
+    m_alloc = std::move(rhs.m_alloc);
+    steal(rhs);
+  } else {
+    if (m_alloc == rhs.m_alloc) {
+      release();
+      steal(rhs);
+    } else {
+      assign_n(std::make_move_iterator(rhs.m_buffer + rhs.m_front), rhs.size());
+      rhs.clear();
+    }
+  }
+  return *this;
+}
+
+/// Returns a copy of the allocator associated with the devector.
+allocator_type get_allocator() const { return m_alloc; }
+
+  //=== [II] ITERATORS
+iterator begin() { return iterator{m_buffer + m_front}; }
+iterator end() { return iterator(m_buffer + m_back); }
+const_iterator begin() const { return const_iterator(m_buffer + m_front); }
+const_iterator end() const { return const_iterator(m_buffer + m_back); }
+const_iterator cbegin() const { return const_iterator(m_buffer + m_front); }
+const_iterator cend() const { return const_iterator(m_buffer + m_back); }
+
+  // [III] Capacity
+[[nodiscard]] bool full() const { return size() == m_capacity; }
+[[nodiscard]] size_type size() const { return m_back - m_front; }
+[[nodiscard]] size_type capacity() const { return m_capacity; }
+[[nodiscard]] bool empty() const { return m_back == m_front; }
+/// Free slots before the first element.
+[[nodiscard]] size_type front_free_capacity() const { return m_front; }
+/// Free slots after the last element.
+[[nodiscard]] size_type back_free_capacity() const { return m_capacity - m_back; }
+
+  // [IV] Modifiers
+void clear(){
+  destroy(m_buffer + m_front, m_buffer + m_back);
+  m_front = m_back = m_capacity / 2;
+}
+
+/**
+ * @brief Inserts an element at the beginning, in amortized O(1).
+ *
+ * @param value The value to be inserted.
+ */
+void push_front(const_reference value){ emplace_front(value); }
+
+/**
+ * @brief Inserts an element at the beginning, moving it in.
+ *
+ * @param value The value to be inserted.
+ */
+void push_front(value_type &&value){ emplace_front(std::move(value)); }
+
+/**
+ * @brief Inserts an element at the end, in amortized O(1).
+ *
+ * @param value The value to be inserted.
+ */
+void push_back(const_reference value){ emplace_back(value); }
+
+/**
+ * @brief Inserts an element at the end, moving it in.
+ *
+ * @param value The value to be inserted.
+ */
+void push_back(value_type &&value){ emplace_back(std::move(value)); }
+
+/**
+ * @brief Constructs an element in place at the beginning.
+ *
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ */
+template <typename... Args>
+reference emplace_front(Args &&...args){
+  if (m_front == 0){
+    // The arguments may refer to an element that is about to be moved.
+    value_type tmp(std::forward<Args>(args)...);
+    fill_room(0, 1, [&](pointer slot) { construct_at(slot, std::move(tmp)); });
+  } else {
+    construct_at(m_buffer + m_front - 1, std::forward<Args>(args)...);
+    --m_front;
+  }
+  return m_buffer[m_front];
+}
+
+/**
+ * @brief Constructs an element in place at the end.
+ *
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ */
+template <typename... Args>
+reference emplace_back(Args &&...args){
+  if (m_back == m_capacity){
+    // The arguments may refer to an element that is about to be moved.
+    value_type tmp(std::forward<Args>(args)...);
+    fill_room(size(), 1, [&](pointer slot) { construct_at(slot, std::move(tmp)); });
+  } else {
+    construct_at(m_buffer + m_back, std::forward<Args>(args)...);
+    ++m_back;
+  }
+  return m_buffer[m_back - 1];
+}
+
+/**
+ * @brief Constructs an element in place right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return An iterator pointing to the new element.
+ */
+template <typename... Args>
+iterator emplace(const_iterator pos, Args &&...args){
+  const size_type idx = pos - cbegin();
+  value_type tmp(std::forward<Args>(args)...);
+  fill_room(idx, 1, [&](pointer slot) { construct_at(slot, std::move(tmp)); });
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes the last element.
+ *
+ * @throws std::length_error if the devector is empty.
+ */
+void pop_back(){
+  if(empty()){throw std::length_error("POP_BACK(EMPTY)\n");}
+  destroy_at(m_buffer + --m_back);
+  if (empty()){ m_front = m_back = m_capacity / 2; }
+}
+
+/**
+ * @brief Removes the first element, in O(1).
+ *
+ * @throws std::length_error if the devector is empty.
+ */
+void pop_front(){
+  if(empty()){throw std::length_error("POP_FRONT(EMPTY)\n");}
+  destroy_at(m_buffer + m_front++);
+  if (empty()){ m_front = m_back = m_capacity / 2; }
+}
+
+/**
+ * @brief Inserts the range [first, last) right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the elements will be inserted.
+ * @param first Iterator to the beginning of the range of elements to insert.
+ * @param last Iterator to the end of the range of elements to insert.
+ * @return An iterator pointing to the first inserted element, or pos if the range is empty.
+ */
+template<typename InputItr>
+iterator insert(const_iterator pos, InputItr first, InputItr last){
+  const size_type idx = pos - cbegin();
+  const size_type count = std::distance(first, last);
+  if (count == 0) { return begin() + idx; }
+  fill_room(idx, count, [&](pointer gap) { construct_copies(first, count, gap); });
+  return begin() + idx;
+}
+
+/**
+ * @brief Inserts the elements of `ilist` right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the elements will be inserted.
+ * @param ilist Initializer list containing elements to insert.
+ * @return An iterator pointing to the first inserted element, or pos if the list is empty.
+ */
+iterator insert(const_iterator pos, const std::initializer_list<value_type> &ilist){
+  return insert(pos, ilist.begin(), ilist.end());
+}
+
+/**
+ * @brief Inserts a copy of `value` right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param value The value to be inserted.
+ * @return An iterator pointing to the inserted element.
+ */
+iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+
+/**
+ * @brief Moves `value` in right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param value The value to be inserted.
+ * @return An iterator pointing to the inserted element.
+ */
+iterator insert(const_iterator pos, value_type &&value) { return emplace(pos, std::move(value)); }
+
+/**
+ * @brief Increases the capacity to at least `new_cap`.
+ *
+ * The elements keep the front gap they have; all the new room goes to the back.
+ *
+ * @param new_cap The new capacity.
+ */
+void reserve(size_type new_cap){
+  if (new_cap <= m_capacity){ return; }
+  relayout(new_cap, m_front, size(), 0);
+}
+
+/**
+ * @brief Increases the free room before the first element to at least `n`.
+ *
+ * @param n The number of push_front() calls that will not reallocate.
+ */
+void reserve_front(size_type n){
+  if (n <= m_front){ return; }
+  relayout(n + size() + back_free_capacity(), n, size(), 0);
+}
+
+/**
+ * @brief Reduces the capacity to fit the size, dropping both gaps.
+ */
+void shrink_to_fit(){
+  if (size() == m_capacity){ return; }
+  relayout(size(), 0, size(), 0);
+}
+
+/**
+ * @brief Replaces the contents with the elements from [first, last).
+ *
+ * @param first Iterator to the beginning of the range of elements to assign.
+ * @param last Iterator to the end of the range of elements to assign.
+ */
+template <typename InputItr>
+void assign(InputItr first, InputItr last) {
+  assign_n(first, std::distance(first, last));
+}
+
+/**
+ * @brief Replaces the contents with `count` copies of `value`.
+ *
+ * @param count The number of elements to assign.
+ * @param value The value to assign to the elements.
+ */
+void assign(size_type count, const_reference value) {
+  // `value` may be one of the elements about to be destroyed.
+  value_type copy(value);
+  clear();
+  fill_room(0, count, [&](pointer gap) { construct_n(gap, count, copy); });
+}
+
+/**
+ * @brief Replaces the contents with the elements of `ilist`.
+ *
+ * @param ilist Initializer list containing elements to assign.
+ */
+void assign(const std::initializer_list<T> &ilist) {
+  assign(ilist.begin(), ilist.end());
+}
+
+/**
+ * @brief Removes the elements in [first, last).
+ *
+ * Whichever side of the range is shorter is shifted to close the gap.
+ *
+ * @param first Iterator pointing to the beginning of the range to erase.
+ * @param last Iterator pointing to the end of the range to erase.
+ * @return An iterator pointing to the position of the first erased element.
+ * @throws std::out_of_range if the container is empty or if the provided iterators are invalid.
+ */
+iterator erase(const_iterator first, const_iterator last) {
+  if (empty()) { throw std::out_of_range("The container is empty."); }
+  if (first < cbegin() || last > cend()) { throw std::out_of_range("Invalid iterators provided."); }
+  const size_type idx = first - cbegin();
+  const size_type count = last - first;
+  if (count == 0) { return begin() + idx; }
+  const size_type from = m_front + idx;
+  const size_type to = from + count;
+  destroy(m_buffer + from, m_buffer + to);
+  if (idx < m_back - to) {
+    shift(m_front, from, static_cast<difference_type>(count));
+    m_front += count;
+  } else {
+    shift(to, m_back, -static_cast<difference_type>(count));
+    m_back -= count;
+  }
+  if (empty()){ m_front = m_back = m_capacity / 2; }
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes the element at `pos`.
+ *
+ * @param pos Iterator pointing to the position of the element to erase.
+ * @return An iterator pointing to the position of the erased element.
+ * @throws std::out_of_range if the container is empty or if the provided iterator is invalid.
+ */
+iterator erase(const_iterator pos){ return erase(pos, std::next(pos)); }
+
+  // [V] Element access
+const_reference back() const {
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_buffer[m_back - 1];
+}
+
+const_reference front() const{
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_buffer[m_front];
+}
+
+reference back(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_buffer[m_back - 1];
+}
+
+reference front(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_buffer[m_front];
+}
+
+const_reference operator[](size_type idx) const { return m_buffer[m_front + idx]; }
+reference operator[](size_type idx) { return m_buffer[m_front + idx]; }
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the devector is empty.
+ * @throws std::out_of_range if pos is not within the range of the devector.
+ */
+const_reference at(size_type pos) const {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= size()) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return m_buffer[m_front + pos];
+}
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the devector is empty.
+ * @throws std::out_of_range if pos is not within the range of the devector.
+ */
+reference at(size_type pos) {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= size()) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return m_buffer[m_front + pos];
+}
+
+pointer data() { return m_buffer + m_front; }
+
+const_pointer data() const { return m_buffer + m_front; }
+
+  // [VII] Friend functions.
+friend std::ostream &operator<<(std::ostream &os, const devector &vec) {
+  os << "{ ";
+  for (auto i{vec.m_front}; i < vec.m_back; ++i) {
+    os << vec.m_buffer[i] << " ";
+  }
+  os << "| }, m_front=" << vec.m_front << ", m_back=" << vec.m_back
+     << ", m_capacity=" << vec.m_capacity;
+  return os;
+}
+
+friend void swap(devector &first, devector &second) noexcept {
+  using std::swap;
+  if constexpr (alloc_traits::propagate_on_container_swap::value) {
+    swap(first.m_alloc, second.m_alloc);
+  }
+  swap(first.m_front, second.m_front);
+  swap(first.m_back, second.m_back);
+  swap(first.m_capacity, second.m_capacity);
+  swap(first.m_buffer, second.m_buffer);
+}
+
+private:
+/// How the elements are built and destroyed (see detail::alloc_ops).
+using element_ops = detail::alloc_ops<Allocator>;
+
+element_ops ops() { return {m_alloc}; }
+
+pointer allocate(size_type n){
+  if (n == 0){ return nullptr; }
+  return alloc_traits::allocate(m_alloc, n);
+}
+
+void deallocate(pointer buffer, size_type cap){
+  if (buffer != nullptr){ alloc_traits::deallocate(m_alloc, buffer, cap); }
+}
+
+template <typename... Args>
+void construct_at(pointer p, Args &&...args){
+  alloc_traits::construct(m_alloc, p, std::forward<Args>(args)...);
+}
+
+void destroy_at(pointer p){ alloc_traits::destroy(m_alloc, p); }
+
+void destroy(pointer first, pointer last){ detail::destroy_range(ops(), first, last); }
+
+/// Destroys the elements and gives the storage back; the devector ends up empty.
+void release(){
+  destroy(m_buffer + m_front, m_buffer + m_back);
+  deallocate(m_buffer, m_capacity);
+  m_buffer = nullptr;
+  m_front = m_back = m_capacity = 0;
+}
+
+/// Takes over the storage of `other`, which is left empty.
+void steal(devector &other) noexcept {
+  m_front = other.m_front;
+  m_back = other.m_back;
+  m_capacity = other.m_capacity;
+  m_buffer = other.m_buffer;
+  other.m_buffer = nullptr;
+  other.m_front = other.m_back = other.m_capacity = 0;
+}
+
+/// Constructs `n` elements read from `first` into the raw memory at `dest`.
+template <typename InputItr>
+void construct_copies(InputItr first, size_type n, pointer dest){
+  detail::construct_copies(ops(), first, n, dest);
+}
+
+/// Constructs `n` elements from the same `args` into the raw memory at `dest`.
+template <typename... Args>
+void construct_n(pointer dest, size_type n, const Args &...args){
+  detail::construct_n(ops(), dest, n, args...);
+}
+
+/**
+ * @brief Moves the elements in slots `[first, last)` by `delta` slots.
+ *
+ * The destination slots outside `[first, last)` must be raw; on return the
+ * source slots outside the destination are raw.
+ */
+void shift(size_type first, size_type last, difference_type delta){
+  if (delta > 0) {
+    // The block opens a gap of `delta` slots in front of itself.
+    detail::open_gap(ops(), m_buffer + first, last - first, 0, delta);
+  } else if (delta < 0) {
+    // The block closes the gap of `-delta` raw slots in front of it.
+    const size_type back = -delta;
+    detail::close_gap(ops(), m_buffer + first - back, last - first, 0, back);
+  }
+}
+
+/**
+ * @brief Lays the elements out on `new_cap` slots, starting at `new_front`,
+ *        with a gap of `count` raw slots right before element `idx`.
+ *
+ * The area is reused when `new_cap` is the current capacity; otherwise a new
+ * one is allocated.
+ */
+void relayout(size_type new_cap, size_type new_front, size_type idx, size_type count){
+  const size_type at = m_front + idx;
+  const size_type n = size();
+  if (new_cap == m_capacity) {
+    const auto prefix_delta = static_cast<difference_type>(new_front) -
+                              static_cast<difference_type>(m_front);
+    const auto suffix_delta = prefix_delta + static_cast<difference_type>(count);
+    // Move the block heading away from the other one first.
+    if (prefix_delta < 0) {
+      shift(m_front, at, prefix_delta);
+      shift(at, m_back, suffix_delta);
+    } else {
+      shift(at, m_back, suffix_delta);
+      shift(m_front, at, prefix_delta);
+    }
+  } else {
+    pointer new_buffer = allocate(new_cap);
+    // The old elements are only released once both halves made it across.
+    try {
+      detail::transfer_around(ops(), m_buffer + m_front, n, idx, count, new_buffer + new_front);
+    } catch (...) {
+      deallocate(new_buffer, new_cap);
+      throw;
+    }
+    detail::release_transferred(ops(), m_buffer + m_front, m_buffer + m_back);
+    deallocate(m_buffer, m_capacity);
+    m_buffer = new_buffer;
+    m_capacity = new_cap;
+  }
+  m_front = new_front;
+  m_back = new_front + n + count;
+}
+
+/**
+ * @brief Opens a gap of `count` raw slots right before element `idx`.
+ *
+ * The shorter side is shifted if it has room; otherwise the elements are
+ * re-centered, in place when the storage stays at most half full, or into a
+ * bigger area chosen by the growth policy. The gap is counted in size() on
+ * return, so the caller must construct `count` elements there (see
+ * fill_room()).
+ *
+ * @return A pointer to the first slot of the gap.
+ */
+pointer make_room(size_type idx, size_type count){
+  const size_type n = size();
+  if (idx < n - idx) {
+    if (m_front >= count) {
+      shift(m_front, m_front + idx, -static_cast<difference_type>(count));
+      m_front -= count;
+      return m_buffer + m_front + idx;
+    }
+  } else if (back_free_capacity() >= count) {
+    shift(m_front + idx, m_back, static_cast<difference_type>(count));
+    m_back += count;
+    return m_buffer + m_front + idx;
+  }
+  const size_type required = n + count;
+  const size_type new_cap = 2 * required <= m_capacity
+                                ? m_capacity
+                                : growth_policy::next_capacity(m_capacity, required);
+  relayout(new_cap, (new_cap - required) / 2, idx, count);
+  return m_buffer + m_front + idx;
+}
+
+/**
+ * @brief Undoes make_room(idx, count) when the gap could not be filled.
+ *
+ * The gap must hold no live object. The elements after it are shifted back
+ * over it and it is no longer counted in size(); the capacity is kept.
+ */
+void close_room(size_type idx, size_type count){
+  const size_type at = m_front + idx;
+  shift(at + count, m_back, -static_cast<difference_type>(count));
+  m_back -= count;
+}
+
+/**
+ * @brief Opens a gap with make_room(idx, count) and has `fill` construct its
+ *        `count` elements.
+ *
+ * If `fill` throws it must leave the gap raw; the gap is then closed again,
+ * so the devector keeps its elements and size().
+ */
+template <typename Fill>
+void fill_room(size_type idx, size_type count, Fill fill){
+  pointer gap = make_room(idx, count);
+  try {
+    fill(gap);
+  } catch (...) {
+    close_room(idx, count);
+    throw;
+  }
+}
+
+/// Replaces the contents with `n` elements read from `first`.
+template <typename InputItr>
+void assign_n(InputItr first, size_type n){
+  clear();
+  fill_room(0, n, [&](pointer gap) { construct_copies(first, n, gap); });
+}
+
+  size_type m_front;    //!< Slot of the first element.
+  size_type m_back;     //!< Slot past the last element.
+  size_type m_capacity; //!< Number of slots in the storage area.
+  T *m_buffer;          //!< The storage area (raw memory).
+  Allocator m_alloc;    //!< Where the storage area comes from.
+};
+
+template <typename T, typename A, typename G>
+bool operator==(const devector<T, A, G> &lhs, const devector<T, A, G> &rhs) {
+  if (lhs.size() != rhs.size()) { return false; }
+  for (typename devector<T, A, G>::size_type i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) { return false; }
+  }
+  return true;
+}
+
+template <typename T, typename A, typename G>
+bool operator!=(const devector<T, A, G> &lhs, const devector<T, A, G> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace sc.
+
+#endif
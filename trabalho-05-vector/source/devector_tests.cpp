@@ -0,0 +1,195 @@
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "devector.h"
+#include "test_types.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+using sc_test::Moved;
+using sc_test::Fragile;
+
+// =============================================================
+// Tests for sc::devector
+// =============================================================
+
+// push_front()/pop_front() do not shift the other elements.
+#define DEVEC_FRONT_OPS YES
+// A FIFO (push_back + pop_front) runs in amortized O(1) per operation.
+#define DEVEC_FIFO YES
+// insert()/erase() in the middle shift the shorter side.
+#define DEVEC_MIDDLE YES
+// The elements stay contiguous: data() works as for sc::vector.
+#define DEVEC_CONTIGUOUS YES
+// Copy, move, assign and swap.
+#define DEVEC_COPY_MOVE YES
+// A throwing copy in insert(), in place or while growing, changes nothing.
+#define DEVEC_ROLLBACK YES
+
+void run_devector_tests(void) {
+  TestManager tm{"devector testing"};
+
+#if DEVEC_FRONT_OPS
+  {
+    BEGIN_TEST(tm, "DevecFrontOps", "push_front()/pop_front() in O(1)");
+    sc::devector<Moved> vec;
+    vec.reserve_front(1000);
+    EXPECT_EQ(vec.front_free_capacity(), 1000u);
+    Moved::transfers = 0;
+    for (int i{0}; i < 1000; ++i)
+      vec.push_front(Moved{i});
+    // One move per element: from the temporary into its slot.
+    EXPECT_EQ(Moved::transfers, 1000);
+    EXPECT_EQ(vec.front().value, 999);
+    EXPECT_EQ(vec.back().value, 0);
+    Moved::transfers = 0;
+    for (int i{0}; i < 500; ++i)
+      vec.pop_front();
+    EXPECT_EQ(Moved::transfers, 0);
+    EXPECT_EQ(vec.front().value, 499);
+    EXPECT_EQ(vec.size(), 500u);
+  }
+#endif
+
+#if DEVEC_FIFO
+  {
+    BEGIN_TEST(tm, "DevecFifo", "push_back() + pop_front() as a queue");
+    sc::devector<Moved> queue;
+    for (int i{0}; i < 100; ++i)
+      queue.push_back(Moved{i});
+    Moved::transfers = 0;
+    const int n_ops{100'000};
+    for (int i{100}; i < 100 + n_ops; ++i) {
+      queue.push_back(Moved{i});
+      queue.pop_front();
+    }
+    EXPECT_EQ(queue.size(), 100u);
+    EXPECT_EQ(queue.front().value, n_ops);
+    EXPECT_EQ(queue.back().value, n_ops + 99);
+    // Besides the one move per push, re-centering costs O(1) amortized.
+    EXPECT_LT(Moved::transfers, 4 * n_ops);
+    EXPECT_LT(queue.capacity(), 512u);
+  }
+#endif
+
+#if DEVEC_MIDDLE
+  {
+    BEGIN_TEST(tm, "DevecMiddle", "insert()/erase()/emplace() in the middle");
+    sc::devector<std::string> vec{"1", "2", "3", "4", "5", "6"};
+    vec.insert(vec.cbegin() + 1, {"x", "y"});
+    vec.emplace(vec.cbegin() + 7, 2, 'z');
+    vec.push_front(vec.back());
+    EXPECT_EQ(vec, (sc::devector<std::string>{"6", "1", "x", "y", "2", "3", "4", "5", "zz", "6"}));
+    vec.erase(vec.cbegin() + 1, vec.cbegin() + 3);
+    vec.erase(vec.cbegin() + 6, vec.cbegin() + 8);
+    EXPECT_EQ(vec, (sc::devector<std::string>{"6", "y", "2", "3", "4", "5"}));
+    vec.erase(vec.cbegin(), vec.cend());
+    EXPECT_TRUE(vec.empty());
+    vec.assign(size_t(3), "k");
+    EXPECT_EQ(vec.size(), 3u);
+    EXPECT_EQ(vec.at(2), "k");
+  }
+#endif
+
+#if DEVEC_CONTIGUOUS
+  {
+    BEGIN_TEST(tm, "DevecContiguous", "data() after front and back pushes");
+    sc::devector<int> vec;
+    for (int i{0}; i < 50; ++i) {
+      vec.push_back(i);
+      vec.push_front(-i - 1);
+    }
+    const int *raw = vec.data();
+    EXPECT_EQ(vec.size(), 100u);
+    for (int i{0}; i < 100; ++i)
+      EXPECT_EQ(raw[i], i - 50);
+    EXPECT_TRUE(&*vec.begin() == raw);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 100u);
+    EXPECT_EQ(vec.data()[99], 49);
+  }
+#endif
+
+#if DEVEC_COPY_MOVE
+  {
+    BEGIN_TEST(tm, "DevecCopyMove", "copy, move, assignment and swap");
+    sc::devector<std::string> a{"a", "b", "c"};
+    a.push_front("z");
+    auto copy{a};
+    EXPECT_EQ(copy, a);
+    EXPECT_EQ(copy.front_free_capacity(), a.front_free_capacity());
+    auto moved{std::move(a)};
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(a.empty());
+    a = moved;
+    EXPECT_EQ(a, copy);
+    sc::devector<std::string> b{"q"};
+    b = std::move(a);
+    EXPECT_EQ(b, copy);
+    swap(b, a);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.front(), "z");
+  }
+#endif
+
+#if DEVEC_ROLLBACK
+  {
+    BEGIN_TEST(tm, "DevecRollback", "insert() of 3 elements when any copy throws");
+    Fragile::alive = 0;
+    {
+      const Fragile source[]{Fragile{10}, Fragile{11}, Fragile{12}};
+      // Full storage: growing copies the 4 elements, then the 3 new ones.
+      for (int budget{0}; budget < 7; ++budget) {
+        for (std::size_t at : {1u, 3u}) {
+          sc::devector<Fragile> vec;
+          vec.reserve(4);
+          for (int i{0}; i < 4; ++i)
+            vec.emplace_back(i);
+          Fragile::copies_left = budget;
+          bool thrown{false};
+          try {
+            vec.insert(vec.begin() + at, std::begin(source), std::end(source));
+          } catch (const std::runtime_error &) {
+            thrown = true;
+          }
+          EXPECT_TRUE(thrown);
+          EXPECT_EQ(vec.size(), 4u);
+          for (int i{0}; i < 4; ++i)
+            EXPECT_EQ(vec[i].value, i);
+          EXPECT_EQ(Fragile::alive, 3 + 4);
+        }
+      }
+      // Room on both sides: the shorter side is shifted in place.
+      for (std::size_t at : {1u, 3u}) {
+        sc::devector<Fragile> vec;
+        vec.reserve(32);
+        for (int i{0}; i < 4; ++i)
+          vec.emplace_back(i);
+        vec.reserve_front(8);
+        Fragile::copies_left = 2;
+        bool thrown{false};
+        try {
+          vec.insert(vec.begin() + at, std::begin(source), std::end(source));
+        } catch (const std::runtime_error &) {
+          thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+        EXPECT_EQ(vec.size(), 4u);
+        for (int i{0}; i < 4; ++i)
+          EXPECT_EQ(vec[i].value, i);
+        vec.push_back(4);
+        EXPECT_EQ(vec.back().value, 4);
+        EXPECT_EQ(Fragile::alive, 3 + 5);
+      }
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
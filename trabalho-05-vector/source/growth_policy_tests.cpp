@@ -0,0 +1,135 @@
+#include <cstddef>
+#include <iostream>
+#include <memory>
+
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Tests for the capacity growth policies of sc::vector
+// =============================================================
+
+// Default policy doubles the capacity.
+#define GROWTH_DOUBLING YES
+// 1.5x growth.
+#define GROWTH_ONE_AND_HALF YES
+// Linear growth by a fixed step.
+#define GROWTH_FIXED_STEP YES
+// A policy supplied by the client code.
+#define GROWTH_CUSTOM YES
+// push_front, insert and assign follow the policy as well.
+#define GROWTH_OTHER_MODIFIERS YES
+
+namespace {
+/// Counts how many times the capacity changes while pushing `n` elements.
+template <typename Vector> size_t count_reallocations(Vector &vec, size_t n) {
+  size_t reallocations{0};
+  auto last_cap = vec.capacity();
+  for (size_t i{0}; i < n; ++i) {
+    vec.push_back(static_cast<int>(i));
+    if (vec.capacity() != last_cap) {
+      ++reallocations;
+      last_cap = vec.capacity();
+    }
+  }
+  return reallocations;
+}
+
+/// Client-defined policy: always grows to the next multiple of 100.
+struct round_to_hundred {
+  static constexpr size_t next_capacity(size_t, size_t required) {
+    return (required + 99) / 100 * 100;
+  }
+};
+} // namespace
+
+void run_growth_policy_tests(void) {
+  TestManager tm{"Growth policy testing"};
+
+#if GROWTH_DOUBLING
+  {
+    BEGIN_TEST(tm, "GrowthDoubling", "vector<int> grows 1, 2, 4, 8...");
+
+    sc::vector<int> vec;
+    auto reallocations = count_reallocations(vec, 1000);
+
+    EXPECT_EQ(vec.size(), 1000);
+    EXPECT_EQ(vec.capacity(), 1024);
+    EXPECT_EQ(reallocations, 11);
+    for (auto i{0u}; i < vec.size(); ++i)
+      EXPECT_EQ(vec[i], (int)i);
+  }
+#endif
+
+#if GROWTH_ONE_AND_HALF
+  {
+    BEGIN_TEST(tm, "GrowthOneAndHalf", "vector<int, one_and_half>");
+
+    sc::vector<int, std::allocator<int>, sc::growth::one_and_half> vec;
+    auto reallocations = count_reallocations(vec, 1000);
+
+    EXPECT_EQ(vec.size(), 1000);
+    EXPECT_GE(vec.capacity(), 1000);
+    EXPECT_LT(vec.capacity(), 1500);
+    EXPECT_LT(reallocations, 20);
+    for (auto i{0u}; i < vec.size(); ++i)
+      EXPECT_EQ(vec[i], (int)i);
+  }
+#endif
+
+#if GROWTH_FIXED_STEP
+  {
+    BEGIN_TEST(tm, "GrowthFixedStep", "vector<int, fixed_step<64>>");
+
+    sc::vector<int, std::allocator<int>, sc::growth::fixed_step<64>> vec;
+    auto reallocations = count_reallocations(vec, 1000);
+
+    EXPECT_EQ(vec.size(), 1000);
+    EXPECT_EQ(vec.capacity(), 1024);
+    EXPECT_EQ(reallocations, 16);
+  }
+#endif
+
+#if GROWTH_CUSTOM
+  {
+    BEGIN_TEST(tm, "GrowthCustom", "vector<int, user_policy>");
+
+    sc::vector<int, std::allocator<int>, round_to_hundred> vec;
+    auto reallocations = count_reallocations(vec, 250);
+
+    EXPECT_EQ(vec.size(), 250);
+    EXPECT_EQ(vec.capacity(), 300);
+    EXPECT_EQ(reallocations, 3);
+  }
+#endif
+
+#if GROWTH_OTHER_MODIFIERS
+  {
+    BEGIN_TEST(tm, "GrowthOtherModifiers", "push_front, insert and assign");
+
+    sc::vector<int> vec;
+    for (int i{0}; i < 100; ++i)
+      vec.push_front(i);
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(vec.capacity(), 128);
+    EXPECT_EQ(vec.front(), 99);
+    EXPECT_EQ(vec.back(), 0);
+
+    sc::vector<int> vec2{1, 2, 3, 4};
+    vec2.insert(vec2.begin(), {5, 6});
+    EXPECT_EQ(vec2.size(), 6);
+    EXPECT_EQ(vec2.capacity(), 8);
+
+    sc::vector<int, std::allocator<int>, sc::growth::fixed_step<10>> vec3{1, 2, 3};
+    vec3.assign(size_t(5), 7);
+    EXPECT_EQ(vec3.size(), 5);
+    EXPECT_EQ(vec3.capacity(), 13);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
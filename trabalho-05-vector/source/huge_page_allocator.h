@@ -0,0 +1,120 @@
+#ifndef _HUGE_PAGE_ALLOCATOR_H_
+#define _HUGE_PAGE_ALLOCATOR_H_
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <limits>  // std::numeric_limits
+#include <memory>  // std::allocator
+#include <new>     // std::bad_alloc, std::bad_array_new_length
+
+#if defined(__linux__)
+#include <sys/mman.h> // mmap, munmap, madvise
+#define SC_HAS_HUGE_PAGES 1
+#else
+#define SC_HAS_HUGE_PAGES 0
+#endif
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Allocator that backs large blocks with transparent huge pages.
+/*!
+ * Blocks of at least `threshold()` bytes are mapped straight from the kernel,
+ * aligned to a 2 MiB boundary and rounded up to whole 2 MiB pages, and then
+ * marked with `madvise(MADV_HUGEPAGE)`. Each huge page then takes a single
+ * TLB entry instead of 512, which is what random access over a buffer of
+ * several GB needs. If the kernel refuses the advice (THP disabled), the
+ * block simply stays on regular pages.
+ *
+ * Smaller blocks come from std::allocator, so a vector that starts small
+ * switches to huge pages by itself once reserve() or growth crosses the
+ * threshold:
+ * \code
+ * sc::vector<std::uint64_t, sc::huge_page_allocator<std::uint64_t>> table;
+ * table.reserve(std::size_t{1} << 29); // 4 GiB, on huge pages.
+ * \endcode
+ *
+ * On systems other than Linux every block comes from std::allocator.
+ */
+template <typename T> class huge_page_allocator {
+public:
+  using value_type = T;
+
+  /// Size of a (x86-64 / AArch64 4K granule) transparent huge page.
+  static constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+  /// Blocks from this size up go on huge pages, unless told otherwise.
+  static constexpr std::size_t default_threshold = 4 * huge_page_size;
+
+  /// Maps blocks of at least `threshold` bytes on huge pages.
+  explicit huge_page_allocator(std::size_t threshold = default_threshold) noexcept
+      : m_threshold{threshold} {}
+  template <typename U>
+  huge_page_allocator(const huge_page_allocator<U> &other) noexcept
+      : m_threshold{other.threshold()} {}
+
+  /// Smallest block, in bytes, that is mapped on huge pages.
+  [[nodiscard]] std::size_t threshold() const noexcept { return m_threshold; }
+
+  T *allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    if (!on_huge_pages(n)) { return std::allocator<T>{}.allocate(n); }
+#if SC_HAS_HUGE_PAGES
+    const std::size_t length = mapped_length(n);
+    // Over-map by one huge page, so an aligned window always fits inside.
+    void *raw = ::mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) { throw std::bad_alloc(); }
+
+    const auto first = reinterpret_cast<std::uintptr_t>(raw);
+    const auto aligned = (first + huge_page_size - 1) & ~(huge_page_size - 1);
+    // Give back the misaligned head and the unused tail.
+    if (aligned != first) { ::munmap(raw, aligned - first); }
+    const std::size_t tail = huge_page_size - (aligned - first);
+    if (tail != 0) { ::munmap(reinterpret_cast<void *>(aligned + length), tail); }
+
+    auto *block = reinterpret_cast<void *>(aligned);
+#ifdef MADV_HUGEPAGE
+    ::madvise(block, length, MADV_HUGEPAGE); // Failure just means regular pages.
+#endif
+    return static_cast<T *>(block);
+#else
+    return std::allocator<T>{}.allocate(n);
+#endif
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    if (!on_huge_pages(n)) {
+      std::allocator<T>{}.deallocate(p, n);
+      return;
+    }
+#if SC_HAS_HUGE_PAGES
+    ::munmap(static_cast<void *>(p), mapped_length(n));
+#endif
+  }
+
+  friend bool operator==(const huge_page_allocator &lhs, const huge_page_allocator &rhs) {
+    return lhs.m_threshold == rhs.m_threshold;
+  }
+  friend bool operator!=(const huge_page_allocator &lhs, const huge_page_allocator &rhs) {
+    return !(lhs == rhs);
+  }
+
+private:
+  /// Whether a block of `n` elements is mapped on huge pages.
+  [[nodiscard]] bool on_huge_pages(std::size_t n) const noexcept {
+    return SC_HAS_HUGE_PAGES && n * sizeof(T) >= m_threshold;
+  }
+
+  /// Bytes mapped for `n` elements: whole huge pages.
+  static std::size_t mapped_length(std::size_t n) noexcept {
+    return (n * sizeof(T) + huge_page_size - 1) & ~(huge_page_size - 1);
+  }
+
+  std::size_t m_threshold; //!< Smallest block, in bytes, put on huge pages.
+};
+
+} // namespace sc.
+
+#endif
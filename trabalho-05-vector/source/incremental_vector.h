@@ -0,0 +1,512 @@
+#ifndef _INCREMENTAL_VECTOR_H_
+#define _INCREMENTAL_VECTOR_H_
+
+#include "index_iterator.h" // sc::index_iterator
+#include "vector.h"         // sc::detail, sc::growth, sc::is_trivially_relocatable
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Vector whose reallocations are spread over the following operations.
+/*!
+ * When sc::vector runs out of room, the one push_back() that reallocates
+ * moves every element at once, which for a vector of 100M elements is a
+ * stall of hundreds of milliseconds. sc::incremental_vector allocates the new
+ * storage area at that point as well, but then moves at most
+ * `migration_step()` elements per modifying operation (push_back(),
+ * emplace_back(), pop_back()), like the incremental rehashing of some hash
+ * tables. No single operation does more than O(migration_step()) work, so
+ * the step is the latency budget, in elements.
+ *
+ * While a migration is in progress the elements live in two storage areas:
+ *
+ *     new: [ e0 ... e(m-1) | raw ............. | e(s) ... e(n-1) | raw ]
+ *     old: [ raw ......... | e(m) ... e(s-1)   ]
+ *            migrated (m)    split (s)           appended after the growth
+ *
+ * and operator[] picks the right one with a single comparison. Iterators are
+ * index based, so they stay valid across migration steps; data() is not
+ * offered, since the elements are not always contiguous. finish_migration()
+ * completes a migration at once when that is needed.
+ *
+ * With a geometric growth policy a migration always ends before the new
+ * area fills up. Should the storage need to grow again while a migration is
+ * still running (e.g. a fixed step policy, or a large reserve()), the
+ * pending elements are moved at once first.
+ *
+ * The operation that moves the last pending element also gives the old area
+ * back, and deallocating a large area (`munmap` of its pages) takes time in
+ * proportion to its size. To keep that off the latency budget too, pick a
+ * reclamation policy that defers it, e.g. sc::reclaim::background in
+ * reclaimer.h.
+ *
+ * \tparam T The type of the elements.
+ * \tparam Allocator The allocator used to acquire the storage areas.
+ * \tparam GrowthPolicy How the capacity grows (see sc::growth).
+ * \tparam ReclaimPolicy When released storage areas are deallocated (see
+ *         sc::reclaim).
+ */
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = growth::doubling,
+          typename ReclaimPolicy = reclaim::immediate>
+class incremental_vector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Allocator::value_type must be the same as T");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T *>,
+                "sc::incremental_vector requires an allocator with raw pointers");
+
+  //=== Aliases
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using const_pointer = const value_type *; //!< Pointer to a const value.
+  using reference = value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value stored in the container.
+  using iterator = index_iterator<incremental_vector, value_type>; //!< The (index based) iterator.
+  using const_iterator = index_iterator<const incremental_vector, const value_type>; //!< The const_iterator.
+  using allocator_type = Allocator;   //!< The allocator type.
+  using growth_policy = GrowthPolicy; //!< The capacity growth policy.
+  using reclaim_policy = ReclaimPolicy; //!< The storage reclamation policy.
+
+  /// Elements moved per operation when no step is given.
+  static constexpr size_type default_migration_step = 4096;
+
+  //=== [I] SPECIAL MEMBERS
+/**
+ * @brief Constructs an empty vector, without allocating any memory.
+ */
+incremental_vector() : incremental_vector(default_migration_step) {}
+
+/**
+ * @brief Constructs an empty vector that migrates `step` elements per operation.
+ *
+ * @param step The migration step (0 is taken as 1).
+ * @param alloc The allocator to use.
+ */
+explicit incremental_vector(size_type step, const Allocator &alloc = Allocator())
+  : m_step{std::max<size_type>(step, 1)}, m_alloc{alloc} {}
+
+/**
+ * @brief Constructs a vector with the elements of an initializer list.
+ *
+ * @param il The initializer list.
+ * @param step The migration step.
+ * @param alloc The allocator to use.
+ */
+incremental_vector(const std::initializer_list<T> &il, size_type step = default_migration_step,
+                   const Allocator &alloc = Allocator())
+  : incremental_vector(step, alloc) {
+  reserve_now(il.size());
+  for (const auto &value : il){ emplace_back(value); }
+}
+
+/**
+ * @brief Copy constructor; the copy holds its elements in a single area.
+ *
+ * @param other The vector to copy from.
+ */
+incremental_vector(const incremental_vector &other)
+  : incremental_vector(other.m_step,
+                       alloc_traits::select_on_container_copy_construction(other.m_alloc)) {
+  reserve_now(other.m_end);
+  for (const auto &value : other){ emplace_back(value); }
+}
+
+/**
+ * @brief Move constructor: takes over both storage areas of `other` in O(1).
+ *
+ * @param other The vector to move from.
+ */
+incremental_vector(incremental_vector &&other) noexcept
+  : m_step{other.m_step}, m_alloc{std::move(other.m_alloc)} {
+  steal(other);
+}
+
+/**
+ * @brief Destructor.
+ */
+~incremental_vector() { release(); }
+
+/**
+ * @brief Copy assignment operator.
+ *
+ * @param rhs The vector to copy from.
+ * @return Reference to the modified vector.
+ */
+incremental_vector &operator=(const incremental_vector &rhs) {
+  if (this == &rhs) { return *this; }
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+    if (m_alloc != rhs.m_alloc) { release(); }
+    m_alloc = rhs.m_alloc;
+  }
+  refill(rhs.begin(), rhs.end(), rhs.m_end);
+  m_step = rhs.m_step;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ *
+ * Takes over the storage of `rhs` when our allocator can release it;
+ * otherwise the elements are moved one by one. `rhs` is left empty.
+ *
+ * @param rhs The vector to move from.
+ * @return Reference to the modified vector.
+ */
+incremental_vector &operator=(incremental_vector &&rhs) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value) {
+  if (this == &rhs) { return *this; }
+  if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+    if (m_alloc != rhs.m_alloc) {
+      refill(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()), rhs.m_end);
+      m_step = rhs.m_step;
+      rhs.clear();
+      return *this;
+    }
+  }
+  release();
+  if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+    m_alloc = std::move(rhs.m_alloc);
+  }
+  m_step = rhs.m_step;
+  steal(rhs);
+  return *this;
+}
+
+/// Returns a copy of the allocator associated with the vector.
+allocator_type get_allocator() const { return m_alloc; }
+
+  //=== [II] ITERATORS
+iterator begin() { return iterator{this, 0}; }
+iterator end() { return iterator{this, m_end}; }
+const_iterator begin() const { return const_iterator{this, 0}; }
+const_iterator end() const { return const_iterator{this, m_end}; }
+const_iterator cbegin() const { return begin(); }
+const_iterator cend() const { return end(); }
+
+  // [III] Capacity
+[[nodiscard]] bool full() const { return m_end == m_capacity; }
+[[nodiscard]] size_type size() const { return m_end; }
+/// Number of slots in the (new) storage area.
+[[nodiscard]] size_type capacity() const { return m_capacity; }
+[[nodiscard]] bool empty() const { return m_end == 0; }
+/// Whether some elements still live in the old storage area.
+[[nodiscard]] bool migrating() const { return m_old != nullptr; }
+/// Most elements moved by a single operation.
+[[nodiscard]] size_type migration_step() const { return m_step; }
+/// Changes the number of elements moved per operation (0 is taken as 1).
+void set_migration_step(size_type step) { m_step = std::max<size_type>(step, 1); }
+
+  // [IV] Modifiers
+/// Destroys every element; a migration in progress ends with it.
+void clear(){
+  for (size_type i{0}; i < m_end; ++i){ alloc_traits::destroy(m_alloc, slot(i)); }
+  m_end = 0;
+  drop_old();
+}
+
+/**
+ * @brief Inserts an element at the end.
+ *
+ * @param value The value to be inserted.
+ */
+void push_back(const_reference value){ emplace_back(value); }
+
+/**
+ * @brief Inserts an element at the end, moving it in.
+ *
+ * @param value The value to be inserted.
+ */
+void push_back(value_type &&value){ emplace_back(std::move(value)); }
+
+/**
+ * @brief Constructs an element in place at the end.
+ *
+ * When the vector is full a new storage area is allocated, but the elements
+ * are not moved yet. Then up to migration_step() pending elements are moved.
+ *
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ */
+template <typename... Args>
+reference emplace_back(Args &&...args){
+  if (m_end == m_capacity && migrating()){
+    // Growing again completes the migration, which would move an element the
+    // arguments may refer to.
+    value_type tmp(std::forward<Args>(args)...);
+    finish_migration();
+    return emplace_back(std::move(tmp));
+  }
+  if (m_end == m_capacity){
+    // The elements stay in the old area for now, so the arguments may still
+    // refer to one of them.
+    start_migration(growth_policy::next_capacity(m_capacity, m_end + 1));
+  }
+  alloc_traits::construct(m_alloc, m_storage + m_end, std::forward<Args>(args)...);
+  reference added = m_storage[m_end++];
+  migrate(m_step);
+  return added;
+}
+
+/**
+ * @brief Removes the last element.
+ *
+ * @throws std::length_error if the vector is empty.
+ */
+void pop_back(){
+  if(empty()){throw std::length_error("POP_BACK(EMPTY)\n");}
+  alloc_traits::destroy(m_alloc, slot(m_end - 1));
+  --m_end;
+  if (m_split > m_end){ m_split = m_end; }
+  migrate(m_step);
+}
+
+/**
+ * @brief Makes room for at least `new_cap` elements.
+ *
+ * Like a growth, this only allocates: the elements are then moved by the
+ * following operations.
+ *
+ * @param new_cap The requested capacity.
+ */
+void reserve(size_type new_cap){
+  if (new_cap > m_capacity){ start_migration(new_cap); }
+}
+
+/**
+ * @brief Reduces the capacity to the size.
+ *
+ * Unlike the other operations this is O(size()): any pending migration is
+ * completed and the elements are moved to a storage area of their own size.
+ */
+void shrink_to_fit(){
+  finish_migration();
+  if (m_end == m_capacity){ return; }
+  start_migration(m_end);
+  finish_migration();
+}
+
+/// Moves every pending element at once (O(size())).
+void finish_migration(){ migrate(m_split); }
+
+  // [V] Element access
+const_reference back() const {
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *slot(m_end - 1);
+}
+
+const_reference front() const{
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *slot(0);
+}
+
+reference back(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *slot(m_end - 1);
+}
+
+reference front(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *slot(0);
+}
+
+const_reference operator[](size_type idx) const { return *slot(idx); }
+reference operator[](size_type idx) { return *slot(idx); }
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the vector is empty.
+ * @throws std::out_of_range if pos is not within the range of the vector.
+ */
+const_reference at(size_type pos) const {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_end) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return *slot(pos);
+}
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the vector is empty.
+ * @throws std::out_of_range if pos is not within the range of the vector.
+ */
+reference at(size_type pos) {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_end) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return *slot(pos);
+}
+
+  // [VII] Friend functions.
+friend std::ostream &operator<<(std::ostream &os, const incremental_vector &vec) {
+  os << "{ ";
+  for (auto i{0U}; i < vec.m_end; ++i) {
+    os << vec[i] << " ";
+  }
+  os << "| }, m_end=" << vec.m_end << ", m_capacity=" << vec.m_capacity
+     << ", pending=" << vec.m_split - vec.m_migrated;
+  return os;
+}
+
+/**
+ * @brief Swaps the contents (and migration state) of two vectors in O(1).
+ *
+ * The allocators are swapped only if the allocator type asks for it
+ * (`propagate_on_container_swap`); otherwise they must be equal.
+ */
+friend void swap(incremental_vector &first, incremental_vector &second) noexcept {
+  using std::swap;
+  if constexpr (alloc_traits::propagate_on_container_swap::value) {
+    swap(first.m_alloc, second.m_alloc);
+  }
+  swap(first.m_storage, second.m_storage);
+  swap(first.m_capacity, second.m_capacity);
+  swap(first.m_end, second.m_end);
+  swap(first.m_old, second.m_old);
+  swap(first.m_old_capacity, second.m_old_capacity);
+  swap(first.m_migrated, second.m_migrated);
+  swap(first.m_split, second.m_split);
+  swap(first.m_step, second.m_step);
+}
+
+private:
+/// Whether elements may be moved around as raw bytes.
+static constexpr bool relocatable =
+    is_trivially_relocatable_v<value_type> && detail::is_plain_construct_allocator<Allocator>::value;
+
+/// Address of the element at `idx`, in whichever area it lives.
+pointer slot(size_type idx) const {
+  if (idx >= m_migrated && idx < m_split){ return m_old + idx; }
+  return m_storage + idx;
+}
+
+/**
+ * @brief Switches to a new storage area of `new_cap` slots.
+ *
+ * The current area becomes the old one and its elements stay there until
+ * migrate() moves them. Any migration still running is completed first.
+ */
+void start_migration(size_type new_cap){
+  finish_migration();
+  pointer new_storage = alloc_traits::allocate(m_alloc, new_cap);
+  m_old = m_storage;
+  m_old_capacity = m_capacity;
+  m_storage = new_storage;
+  m_capacity = new_cap;
+  m_migrated = 0;
+  m_split = m_end;
+  if (m_split == 0){ drop_old(); }
+}
+
+/// Moves up to `n` pending elements from the old area to the new one.
+void migrate(size_type n){
+  if (!migrating()){ return; }
+  const size_type last = m_split - m_migrated > n ? m_migrated + n : m_split;
+  if constexpr (relocatable) {
+    std::memcpy(static_cast<void *>(m_storage + m_migrated),
+                static_cast<const void *>(m_old + m_migrated),
+                (last - m_migrated) * sizeof(value_type));
+    m_migrated = last;
+  } else {
+    for (; m_migrated < last; ++m_migrated){
+      alloc_traits::construct(m_alloc, m_storage + m_migrated,
+                              std::move_if_noexcept(m_old[m_migrated]));
+      alloc_traits::destroy(m_alloc, m_old + m_migrated);
+    }
+  }
+  if (m_migrated == m_split){ drop_old(); }
+}
+
+/// Gives the old area back; its slots must hold no live element.
+void drop_old(){
+  give_back(m_old, m_old_capacity);
+  m_old = nullptr;
+  m_old_capacity = m_migrated = m_split = 0;
+}
+
+/**
+ * @brief Deallocates the `cap` slots of `area`, which hold no live element.
+ *
+ * The reclamation policy may defer that work, in which case it runs on a
+ * copy of the allocator.
+ */
+void give_back(pointer area, size_type cap){
+  if (area == nullptr){ return; }
+  if (reclaim_policy::defer(cap * sizeof(value_type))){
+    reclaim_policy::submit([alloc = m_alloc, area, cap]() mutable {
+      alloc_traits::deallocate(alloc, area, cap);
+    });
+    return;
+  }
+  alloc_traits::deallocate(m_alloc, area, cap);
+}
+
+/// Makes the vector empty, with room for `capacity` elements in a single area.
+void reserve_now(size_type capacity){
+  reserve(capacity);
+  finish_migration();
+}
+
+/// Replaces the elements with the `count` elements of [first, last).
+template <typename InputItr>
+void refill(InputItr first, InputItr last, size_type count){
+  clear();
+  reserve_now(count);
+  for (; first != last; ++first){ emplace_back(*first); }
+}
+
+/// Destroys the elements and gives both storage areas back.
+void release(){
+  clear();
+  give_back(m_storage, m_capacity);
+  m_storage = nullptr;
+  m_capacity = 0;
+}
+
+/// Takes over the storage areas of `other`, leaving it empty.
+void steal(incremental_vector &other) noexcept {
+  m_storage = std::exchange(other.m_storage, nullptr);
+  m_capacity = std::exchange(other.m_capacity, 0);
+  m_end = std::exchange(other.m_end, 0);
+  m_old = std::exchange(other.m_old, nullptr);
+  m_old_capacity = std::exchange(other.m_old_capacity, 0);
+  m_migrated = std::exchange(other.m_migrated, 0);
+  m_split = std::exchange(other.m_split, 0);
+}
+
+  pointer m_storage{nullptr};   //!< The (new) storage area.
+  size_type m_capacity{0};      //!< Number of slots in m_storage.
+  size_type m_end{0};           //!< Number of elements.
+  pointer m_old{nullptr};       //!< Storage area being migrated from, if any.
+  size_type m_old_capacity{0};  //!< Number of slots in m_old.
+  size_type m_migrated{0};      //!< Elements in [0, m_migrated) are already moved.
+  size_type m_split{0};         //!< Elements in [m_migrated, m_split) are still in m_old.
+  size_type m_step;             //!< Elements moved per operation.
+  Allocator m_alloc;            //!< Where the storage areas come from.
+};
+
+template <typename T, typename A, typename G, typename R>
+bool operator==(const incremental_vector<T, A, G, R> &lhs, const incremental_vector<T, A, G, R> &rhs) {
+  if (lhs.size() != rhs.size()) { return false; }
+  for (typename incremental_vector<T, A, G, R>::size_type i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) { return false; }
+  }
+  return true;
+}
+
+template <typename T, typename A, typename G, typename R>
+bool operator!=(const incremental_vector<T, A, G, R> &lhs, const incremental_vector<T, A, G, R> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "incremental_vector.h"
+#include "test_types.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+using sc_test::Moved;
+
+namespace {
+/// Reclamation policy that keeps every job until run() is called.
+struct held_jobs {
+  static inline std::vector<std::function<void()>> jobs;
+  static bool defer(std::size_t) { return true; }
+  template <typename Job> static void submit(Job &&job) { jobs.emplace_back(std::forward<Job>(job)); }
+  static void run() {
+    for (auto &job : jobs)
+      job();
+    jobs.clear();
+  }
+};
+} // namespace
+
+// =============================================================
+// Tests for sc::incremental_vector
+// =============================================================
+
+// No push_back() moves more than migration_step() elements.
+#define INC_BOUNDED_STEP YES
+// operator[] and iterators see every element while a migration runs.
+#define INC_SPLIT_ACCESS YES
+// pop_back() may remove elements that are still in the old area.
+#define INC_POP_MIGRATING YES
+// Elements are neither leaked nor destroyed twice across migrations.
+#define INC_LIFETIME YES
+// Copy, move, assign, swap, reserve and shrink_to_fit.
+#define INC_COPY_MOVE YES
+// The old area goes to the reclamation policy when a migration ends.
+#define INC_DEFERRED_RELEASE YES
+
+void run_incremental_vector_tests(void) {
+  TestManager tm{"incremental_vector testing"};
+
+#if INC_BOUNDED_STEP
+  {
+    BEGIN_TEST(tm, "IncBoundedStep", "push_back() with migration_step() == 64");
+    sc::incremental_vector<Moved> vec(64);
+    long worst{0};
+    for (int i{0}; i < 10'000; ++i) {
+      Moved::transfers = 0;
+      vec.emplace_back(i);
+      worst = std::max(worst, Moved::transfers);
+    }
+    // With sc::vector the last growth alone moves 8192 elements.
+    EXPECT_EQ(worst, 64);
+    EXPECT_EQ(vec.size(), 10'000u);
+    for (int i{0}; i < 10'000; ++i)
+      EXPECT_EQ(vec[i].value, i);
+  }
+#endif
+
+#if INC_SPLIT_ACCESS
+  {
+    BEGIN_TEST(tm, "IncSplitAccess", "vec[i] across the old and new areas");
+    sc::incremental_vector<int> vec(3);
+    for (int i{0}; i < 16; ++i)
+      vec.push_back(i);
+    // Full at 16: the next push starts a migration of 16 elements.
+    vec.push_back(16);
+    vec.push_back(17);
+    EXPECT_TRUE(vec.migrating());
+    EXPECT_EQ(vec.capacity(), 32u);
+    for (int i{0}; i < 18; ++i)
+      EXPECT_EQ(vec[i], i);
+    EXPECT_EQ(vec.front(), 0);
+    EXPECT_EQ(vec.back(), 17);
+
+    int expected{0};
+    for (auto it = vec.begin(); it != vec.end(); ++it)
+      EXPECT_EQ(*it, expected++);
+    EXPECT_EQ(vec.end() - vec.begin(), 18);
+    vec[10] = 100;
+    EXPECT_EQ(vec.at(10), 100);
+
+    vec.finish_migration();
+    EXPECT_FALSE(vec.migrating());
+    EXPECT_EQ(vec[10], 100);
+    EXPECT_EQ(vec[17], 17);
+  }
+#endif
+
+#if INC_POP_MIGRATING
+  {
+    BEGIN_TEST(tm, "IncPopMigrating", "pop_back() into the old area");
+    sc::incremental_vector<std::string> vec(1);
+    for (int i{0}; i < 8; ++i)
+      vec.push_back(std::to_string(i));
+    vec.push_back("8"); // Starts migrating 8 elements, 1 per operation.
+    EXPECT_TRUE(vec.migrating());
+    vec.pop_back();
+    vec.pop_back();
+    vec.pop_back();
+    EXPECT_EQ(vec.size(), 6u);
+    EXPECT_EQ(vec.back(), "5");
+    while (vec.migrating())
+      vec.pop_back();
+    for (auto i{0u}; i < vec.size(); ++i)
+      EXPECT_EQ(vec[i], std::to_string(i));
+    vec.push_back("x");
+    EXPECT_EQ(vec.back(), "x");
+  }
+#endif
+
+#if INC_LIFETIME
+  {
+    BEGIN_TEST(tm, "IncLifetime", "live objects across growth, pop and clear");
+    Moved::alive = 0;
+    {
+      sc::incremental_vector<Moved> vec(5);
+      for (int i{0}; i < 1000; ++i) {
+        vec.emplace_back(i);
+        if (i % 7 == 0)
+          vec.pop_back();
+      }
+      EXPECT_EQ(Moved::alive, (long)vec.size());
+      vec.push_back(vec.front()); // May alias an element of the old area.
+      EXPECT_EQ(vec.back().value, 1);
+      vec.clear();
+      EXPECT_EQ(Moved::alive, 0);
+      EXPECT_FALSE(vec.migrating());
+      for (int i{0}; i < 100; ++i)
+        vec.emplace_back(i);
+      EXPECT_EQ(Moved::alive, 100);
+    }
+    EXPECT_EQ(Moved::alive, 0);
+  }
+#endif
+
+#if INC_COPY_MOVE
+  {
+    BEGIN_TEST(tm, "IncCopyMove", "copy, move, swap while migrating");
+    sc::incremental_vector<int> vec(2);
+    for (int i{0}; i < 33; ++i)
+      vec.push_back(i);
+    EXPECT_TRUE(vec.migrating());
+
+    sc::incremental_vector<int> copy{vec};
+    EXPECT_FALSE(copy.migrating());
+    EXPECT_EQ(copy, vec);
+    sc::incremental_vector<int> moved{std::move(vec)};
+    EXPECT_TRUE(moved.migrating());
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(vec.empty());
+
+    sc::incremental_vector<int> other{1, 2, 3};
+    swap(other, moved);
+    EXPECT_EQ(other, copy);
+    EXPECT_EQ(moved, (sc::incremental_vector<int>{1, 2, 3}));
+    moved = other;
+    EXPECT_EQ(moved, copy);
+    vec = std::move(other);
+    EXPECT_EQ(vec, copy);
+
+    vec.reserve(1000);
+    EXPECT_EQ(vec.capacity(), 1000u);
+    EXPECT_TRUE(vec.migrating());
+    EXPECT_EQ(vec[32], 32);
+    vec.shrink_to_fit();
+    EXPECT_FALSE(vec.migrating());
+    EXPECT_EQ(vec.capacity(), 33u);
+    EXPECT_EQ(vec, copy);
+  }
+#endif
+
+#if INC_DEFERRED_RELEASE
+  {
+    BEGIN_TEST(tm, "IncDeferredRelease", "incremental_vector<int, ..., held_jobs>");
+    {
+      sc::incremental_vector<int, std::allocator<int>, sc::growth::doubling, held_jobs> vec(2);
+      for (int i{0}; i < 16; ++i)
+        vec.push_back(i);
+      held_jobs::run();
+      // Full at 16: the next pushes migrate the old area, 2 elements at a time.
+      while (vec.size() == 16 or vec.migrating())
+        vec.push_back(int(vec.size()));
+      EXPECT_EQ(held_jobs::jobs.size(), 1u);
+      for (int i{0}; i < int(vec.size()); ++i)
+        EXPECT_EQ(vec[i], i);
+      held_jobs::run();
+    }
+    // The destructor hands over the remaining area as well.
+    EXPECT_EQ(held_jobs::jobs.size(), 1u);
+    held_jobs::run();
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,64 @@
+#ifndef _INDEX_ITERATOR_H_
+#define _INDEX_ITERATOR_H_
+
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <iterator>    // std::random_access_iterator_tag
+#include <type_traits> // std::remove_cv_t, std::enable_if_t, std::is_same_v
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Random access iterator that walks a container through its `operator[]`.
+/*!
+ * Used by the containers whose elements are not one contiguous block,
+ * ring_vector and incremental_vector: it holds the container and a logical
+ * index, and each dereference is a call to `operator[]`.
+ */
+template <typename Container, typename V> class index_iterator {
+public:
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::remove_cv_t<V>;
+  using pointer = V *;
+  using reference = V &;
+  using iterator_category = std::random_access_iterator_tag;
+
+  index_iterator(Container *cont = nullptr, std::size_t idx = 0) : m_cont{cont}, m_idx{idx} {}
+  /// Converts an iterator into a const_iterator.
+  template <typename C, typename U,
+            typename = std::enable_if_t<std::is_same_v<const U, V> && std::is_same_v<const C, Container>>>
+  index_iterator(const index_iterator<C, U> &other) : m_cont{other.m_cont}, m_idx{other.m_idx} {}
+
+  reference operator*() const { return (*m_cont)[m_idx]; }
+  pointer operator->() const { return &(*m_cont)[m_idx]; }
+  reference operator[](difference_type n) const { return (*m_cont)[m_idx + n]; }
+
+  index_iterator &operator++() { ++m_idx; return *this; }
+  index_iterator operator++(int) { auto tmp{*this}; ++m_idx; return tmp; }
+  index_iterator &operator--() { --m_idx; return *this; }
+  index_iterator operator--(int) { auto tmp{*this}; --m_idx; return tmp; }
+  index_iterator &operator+=(difference_type n) { m_idx += n; return *this; }
+  index_iterator &operator-=(difference_type n) { m_idx -= n; return *this; }
+
+  friend index_iterator operator+(index_iterator it, difference_type n) { return it += n; }
+  friend index_iterator operator+(difference_type n, index_iterator it) { return it += n; }
+  friend index_iterator operator-(index_iterator it, difference_type n) { return it -= n; }
+  friend difference_type operator-(const index_iterator &a, const index_iterator &b) {
+    return static_cast<difference_type>(a.m_idx) - static_cast<difference_type>(b.m_idx);
+  }
+
+  friend bool operator==(const index_iterator &a, const index_iterator &b) { return a.m_idx == b.m_idx; }
+  friend bool operator!=(const index_iterator &a, const index_iterator &b) { return a.m_idx != b.m_idx; }
+  friend bool operator<(const index_iterator &a, const index_iterator &b) { return a.m_idx < b.m_idx; }
+  friend bool operator>(const index_iterator &a, const index_iterator &b) { return a.m_idx > b.m_idx; }
+  friend bool operator<=(const index_iterator &a, const index_iterator &b) { return a.m_idx <= b.m_idx; }
+  friend bool operator>=(const index_iterator &a, const index_iterator &b) { return a.m_idx >= b.m_idx; }
+
+private:
+  template <typename, typename> friend class index_iterator;
+  Container *m_cont; //!< The container.
+  std::size_t m_idx;  //!< Logical index (0 is the front).
+};
+
+} // namespace sc.
+
+#endif
@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 #include "tm/test_manager.h"
@@ -61,6 +64,8 @@
 #define EQUAL YES
 // Different operator. it1 != it2
 #define DIFFERENT YES
+// Contiguous random-access iterator. it[n], std::sort, std::to_address
+#define CONTIGUOUS YES
 
 void run_iterator_tests(void) {
   TestManager tm{"Iterator testing"};
@@ -432,5 +437,26 @@ void run_iterator_tests(void) {
   }
 #endif
 
+#if CONTIGUOUS
+  {
+    BEGIN_TEST(tm, "Contiguous", "it[n], std::sort(first, last)");
+
+    using iter = which_lib::vector<int>::iterator;
+    static_assert(std::contiguous_iterator<iter>);
+    static_assert(std::contiguous_iterator<which_lib::vector<int>::const_iterator>);
+    static_assert(std::is_trivially_copyable_v<iter>);
+
+    which_lib::vector<int> vec{5, 3, 1, 4, 2};
+    auto it = vec.begin();
+    EXPECT_EQ(it[2], 1);
+    EXPECT_EQ(*(it + 4), 2);
+    EXPECT_EQ(std::to_address(it + 3), vec.data() + 3);
+    EXPECT_EQ(std::to_address(vec.end()), vec.data() + vec.size());
+
+    std::sort(vec.begin(), vec.end());
+    EXPECT_EQ(vec, (which_lib::vector<int>{1, 2, 3, 4, 5}));
+  }
+#endif
+
   tm.summary();
 }
@@ -15,6 +15,21 @@
 
 
 void run_iterator_tests(void);
+void run_growth_policy_tests(void);
+void run_storage_tests(void);
+void run_modifier_tests(void);
+void run_comparison_tests(void);
+void run_move_semantics_tests(void);
+void run_allocator_tests(void);
+void run_small_vector_tests(void);
+void run_static_vector_tests(void);
+void run_devector_tests(void);
+void run_ring_vector_tests(void);
+void run_vm_vector_tests(void);
+void run_incremental_vector_tests(void);
+void run_reclaim_tests(void);
+void run_simd_tests(void);
+void run_bulk_tests(void);
 
 // ============================================================================
 // TESTING VECTOR AS A CONTAINER OF INTEGERS
@@ -36,5 +51,50 @@ int main( void )
     std::cout << ">>> Testing out iterator operations on vector.\n";
     run_iterator_tests();
 
+    std::cout << ">>> Testing out growth policies on vector.\n";
+    run_growth_policy_tests();
+
+    std::cout << ">>> Testing out element lifetime on the raw storage.\n";
+    run_storage_tests();
+
+    std::cout << ">>> Testing out the bulk and batch modifiers on vector.\n";
+    run_modifier_tests();
+
+    std::cout << ">>> Testing out comparisons on vector.\n";
+    run_comparison_tests();
+
+    std::cout << ">>> Testing out move semantics on vector.\n";
+    run_move_semantics_tests();
+
+    std::cout << ">>> Testing out allocator support on vector.\n";
+    run_allocator_tests();
+
+    std::cout << ">>> Testing out small_vector.\n";
+    run_small_vector_tests();
+
+    std::cout << ">>> Testing out static_vector.\n";
+    run_static_vector_tests();
+
+    std::cout << ">>> Testing out devector.\n";
+    run_devector_tests();
+
+    std::cout << ">>> Testing out ring_vector.\n";
+    run_ring_vector_tests();
+
+    std::cout << ">>> Testing out vm_vector.\n";
+    run_vm_vector_tests();
+
+    std::cout << ">>> Testing out incremental_vector.\n";
+    run_incremental_vector_tests();
+
+    std::cout << ">>> Testing out the reclamation policies.\n";
+    run_reclaim_tests();
+
+    std::cout << ">>> Testing out the SIMD kernels.\n";
+    run_simd_tests();
+
+    std::cout << ">>> Testing out the bulk copy and fill kernels.\n";
+    run_bulk_tests();
+
     return 1;
 }
@@ -0,0 +1,442 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "test_types.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+using sc_test::Fragile;
+using sc_test::Handle;
+using sc_test::Tracked;
+
+// =============================================================
+// Tests for the bulk and batch modifiers of sc::vector
+// =============================================================
+
+// resize() constructs and destroys exactly the elements it adds or drops.
+#define RESIZE_LIFETIME YES
+// resize_for_overwrite() leaves trivial elements for the caller to write.
+#define RESIZE_FOR_OVERWRITE YES
+// append() and append_range() add at the end, growing at most once.
+#define APPEND_BULK YES
+// Single-pass ranges (istream_iterator) are read once, by every range member.
+#define INPUT_ITERATORS YES
+// erase_if()/remove() compact in one pass and destroy the removed tail.
+#define ERASE_IF_COMPACT YES
+// unordered_erase() fills the hole with the last element.
+#define UNORDERED_ERASE YES
+// insert_batch(), erase_indices() and erase_mask() match the one-by-one edits.
+#define BATCH_EDITS YES
+// A throwing copy in insert_batch() leaks nothing.
+#define BATCH_ROLLBACK YES
+
+namespace {
+/// Tells whether remove() on `n` elements cycling through `period` values
+/// agrees with std::remove().
+template <typename T> bool remove_agrees(std::size_t n, int period) {
+  sc::vector<T> vec;
+  for (std::size_t i{0}; i < n; ++i)
+    vec.push_back(T(int(i % period) - 3));
+  sc::vector<T> expected{vec};
+  const std::size_t kept = std::remove(expected.data(), expected.data() + n, T(0)) - expected.data();
+  if (vec.remove(T(0)) != n - kept || vec.size() != kept) { return false; }
+  for (std::size_t i{0}; i < kept; ++i)
+    if (!(vec[i] == expected[i])) { return false; }
+  return true;
+}
+
+/// Single-pass iterator over `value`, `value + 1`, ... that throws when it reads `fail_at`.
+struct FailingInput {
+  using iterator_category = std::input_iterator_tag;
+  using value_type = int;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const int *;
+  using reference = const int &;
+  int value;
+  int fail_at;
+
+  reference operator*() const {
+    if (value == fail_at) { throw std::runtime_error("FailingInput read"); }
+    return value;
+  }
+  FailingInput &operator++() { ++value; return *this; }
+  FailingInput operator++(int) { auto tmp{*this}; ++value; return tmp; }
+  bool operator==(const FailingInput &rhs) const { return value == rhs.value; }
+  bool operator!=(const FailingInput &rhs) const { return value != rhs.value; }
+};
+
+/// Fragile that opts in to sc::is_trivially_relocatable.
+struct RelocFragile : Fragile {
+  using Fragile::Fragile;
+};
+} // namespace
+
+template <> struct sc::is_trivially_relocatable<RelocFragile> : std::true_type {};
+
+void run_modifier_tests(void) {
+  TestManager tm{"Modifier testing"};
+
+#if RESIZE_LIFETIME
+  {
+    BEGIN_TEST(tm, "ResizeLifetime", "resize(n), resize(n, value)");
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec{1, 2, 3};
+      vec.resize(10);
+      EXPECT_EQ(vec.size(), 10u);
+      EXPECT_EQ(Tracked::alive, 10);
+      EXPECT_EQ(vec[2].value, 3);
+      EXPECT_EQ(vec[9].value, 0);
+      vec.resize(2);
+      EXPECT_EQ(Tracked::alive, 2);
+      EXPECT_EQ(vec.back().value, 2);
+      vec.resize(5, vec.front()); // The value may be one of the elements.
+      EXPECT_EQ(Tracked::alive, 5);
+      EXPECT_EQ(vec[4].value, 1);
+      vec.resize(0);
+      EXPECT_TRUE(vec.empty());
+      EXPECT_EQ(Tracked::alive, 0);
+    }
+    sc::vector<int> ints(3);
+    ints.resize(6, 7);
+    EXPECT_EQ(ints, (sc::vector<int>{0, 0, 0, 7, 7, 7}));
+  }
+#endif
+
+#if RESIZE_FOR_OVERWRITE
+  {
+    BEGIN_TEST(tm, "ResizeForOverwrite", "vec.resize_for_overwrite(n)");
+    sc::vector<char> buf;
+    buf.resize_for_overwrite(4096);
+    EXPECT_EQ(buf.size(), 4096u);
+    // Stand-in for read()/recv() writing straight into data().
+    const std::string payload{"hello, world"};
+    std::memcpy(buf.data(), payload.data(), payload.size());
+    buf.resize(payload.size());
+    EXPECT_EQ(std::string(buf.data(), buf.size()), payload);
+
+    // Non-trivial elements are still value-initialized.
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec;
+      vec.resize_for_overwrite(4);
+      EXPECT_EQ(Tracked::constructed, 4);
+      EXPECT_EQ(vec[3].value, 0);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if APPEND_BULK
+  {
+    BEGIN_TEST(tm, "AppendBulk", "append(n, value), append_range(first, last)");
+    sc::vector<std::string> vec{"a"};
+    vec.append(3, "b");
+    const std::string more[]{"c", "d"};
+    vec.append_range(std::begin(more), std::end(more));
+    EXPECT_EQ(vec, (sc::vector<std::string>{"a", "b", "b", "b", "c", "d"}));
+    vec.append(2, vec.front()); // May reallocate under the value.
+    EXPECT_EQ(vec.size(), 8u);
+    EXPECT_EQ(vec.back(), "a");
+
+    sc::vector<int> ints;
+    ints.reserve(4);
+    ints.append(100, 1);
+    EXPECT_EQ(ints.capacity(), 100u);
+    sc::vector<int> other{2, 3};
+    ints.append_range(other.begin(), other.end());
+    EXPECT_EQ(ints.size(), 102u);
+    EXPECT_EQ(ints[101], 3);
+  }
+#endif
+
+#if INPUT_ITERATORS
+  {
+    BEGIN_TEST(tm, "InputIterators", "vector(istream_iterator, istream_iterator)");
+    using in = std::istream_iterator<int>;
+    std::istringstream numbers{"1 2 3 4 5"};
+    sc::vector<int> vec{in{numbers}, in{}};
+    EXPECT_EQ(vec, (sc::vector<int>{1, 2, 3, 4, 5}));
+
+    std::istringstream more{"7 8 9"};
+    vec.insert(vec.begin() + 1, in{more}, in{});
+    EXPECT_EQ(vec, (sc::vector<int>{1, 7, 8, 9, 2, 3, 4, 5}));
+    std::istringstream tail{"10 11"};
+    vec.append_range(in{tail}, in{});
+    EXPECT_EQ(vec.back(), 11);
+    EXPECT_EQ(vec.size(), 10u);
+
+    std::istringstream shorter{"6 6"};
+    vec.assign(in{shorter}, in{});
+    EXPECT_EQ(vec, (sc::vector<int>{6, 6}));
+    std::istringstream longer{"1 2 3"};
+    vec.assign(in{longer}, in{});
+    EXPECT_EQ(vec, (sc::vector<int>{1, 2, 3}));
+
+    Tracked::reset();
+    {
+      std::istringstream values{"4 5 6"};
+      sc::vector<Tracked> tracked{Tracked{1}};
+      tracked.insert(tracked.begin(), std::istream_iterator<int>{values},
+                     std::istream_iterator<int>{});
+      EXPECT_EQ(tracked, (sc::vector<Tracked>{4, 5, 6, 1}));
+      EXPECT_EQ(Tracked::alive, 4);
+
+      // A read that throws takes back the elements appended before it.
+      bool thrown{false};
+      try {
+        tracked.insert(tracked.begin() + 1, FailingInput{10, 13}, FailingInput{20, 13});
+      } catch (const std::runtime_error &) {
+        thrown = true;
+      }
+      EXPECT_TRUE(thrown);
+      EXPECT_EQ(tracked, (sc::vector<Tracked>{4, 5, 6, 1}));
+      EXPECT_EQ(Tracked::alive, 4);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if ERASE_IF_COMPACT
+  {
+    BEGIN_TEST(tm, "EraseIfCompact", "erase_if(vec, pred), erase(vec, value)");
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec;
+      for (int i{0}; i < 1000; ++i)
+        vec.push_back(Tracked{i % 10});
+      const auto removed = vec.erase_if([](const Tracked &t) { return t.value >= 5; });
+      EXPECT_EQ(removed, 500u);
+      EXPECT_EQ(vec.size(), 500u);
+      EXPECT_EQ(Tracked::alive, 500);
+      EXPECT_EQ(vec[5].value, 0);
+      EXPECT_EQ(vec.back().value, 4);
+      // The value is one of the elements.
+      EXPECT_EQ(vec.remove(vec.front()), 100u);
+      EXPECT_EQ(Tracked::alive, 400);
+      EXPECT_EQ(vec.front().value, 1);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+
+    // Trivially copyable elements take the branchless path.
+    sc::vector<int> ints;
+    for (int i{0}; i < 100'000; ++i)
+      ints.push_back(i);
+    EXPECT_EQ(sc::erase_if(ints, [](int x) { return x % 3 != 0; }), 66'666u);
+    EXPECT_EQ(ints.size(), 33'334u);
+    EXPECT_EQ(ints[1], 3);
+    EXPECT_EQ(ints.back(), 99'999);
+    EXPECT_EQ(sc::erase(ints, ints[1]), 1u);
+    EXPECT_EQ(ints[1], 6);
+    EXPECT_EQ(sc::erase(ints, -1), 0u);
+    // The predicate may take the elements by non-const reference.
+    EXPECT_EQ(ints.erase_if([](int &x) { return x % 2 == 0; }), 16'667u);
+    EXPECT_EQ(ints.front(), 9);
+    EXPECT_EQ(ints.back(), 99'999);
+
+    // Arithmetic remove() goes through SIMD blocks, dense and sparse matches.
+    for (std::size_t n : {0u, 1u, 15u, 16u, 17u, 100u, 1001u}) {
+      for (int period : {1, 4, 7, 61}) {
+        EXPECT_TRUE(remove_agrees<signed char>(n, period));
+        EXPECT_TRUE(remove_agrees<short>(n, period));
+        EXPECT_TRUE(remove_agrees<int>(n, period));
+        EXPECT_TRUE(remove_agrees<long long>(n, period));
+        EXPECT_TRUE(remove_agrees<float>(n, period));
+        EXPECT_TRUE(remove_agrees<double>(n, period));
+      }
+    }
+    sc::vector<double> zeros;
+    for (int i{0}; i < 10; ++i) {
+      zeros.push_back(0.0);
+      zeros.push_back(-0.0);
+      zeros.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+    EXPECT_EQ(zeros.remove(std::numeric_limits<double>::quiet_NaN()), 0u);
+    EXPECT_EQ(zeros.remove(0.0), 20u);
+    EXPECT_EQ(zeros.size(), 10u);
+
+    sc::vector<std::string> words{"a", "bb", "a", "ccc", "a"};
+    EXPECT_EQ(sc::erase(words, "a"), 3u);
+    EXPECT_EQ(words, (sc::vector<std::string>{"bb", "ccc"}));
+  }
+#endif
+
+#if UNORDERED_ERASE
+  {
+    BEGIN_TEST(tm, "UnorderedErase", "unordered_erase(pos), unordered_erase_if(pred)");
+    sc::vector<int> vec{0, 1, 2, 3, 4, 5};
+    auto it = vec.unordered_erase(vec.begin() + 1);
+    EXPECT_EQ(*it, 5);
+    EXPECT_EQ(vec, (sc::vector<int>{0, 5, 2, 3, 4}));
+    it = vec.unordered_erase(vec.end() - 1);
+    EXPECT_TRUE(it == vec.end());
+    EXPECT_EQ(vec.size(), 4u);
+
+    // Relocatable elements are moved as bytes: no move ctor, no assignment.
+    sc::vector<Handle> handles;
+    for (int i{0}; i < 10; ++i)
+      handles.emplace_back(i);
+    Handle::moves = 0;
+    handles.unordered_erase(handles.begin());
+    handles.unordered_erase(handles.begin() + 3);
+    EXPECT_EQ(Handle::moves, 0);
+    EXPECT_EQ(handles.size(), 8u);
+    EXPECT_EQ(*handles[0].value, 9);
+    EXPECT_EQ(*handles[3].value, 8);
+
+    Tracked::reset();
+    {
+      sc::vector<Tracked> bag;
+      for (int i{0}; i < 100; ++i)
+        bag.push_back(Tracked{i});
+      const auto removed = bag.unordered_erase_if([](const Tracked &t) { return t.value % 4 != 0; });
+      EXPECT_EQ(removed, 75u);
+      EXPECT_EQ(bag.size(), 25u);
+      EXPECT_EQ(Tracked::alive, 25);
+      int sum{0};
+      for (const auto &t : bag) {
+        EXPECT_EQ(t.value % 4, 0);
+        sum += t.value;
+      }
+      EXPECT_EQ(sum, 1200);
+      EXPECT_EQ(bag.unordered_erase_if([](const Tracked &) { return true; }), 25u);
+      EXPECT_TRUE(bag.empty());
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if BATCH_EDITS
+  {
+    BEGIN_TEST(tm, "BatchEdits", "insert_batch(), erase_indices(), erase_mask()");
+    const std::size_t positions[]{0, 2, 2, 5, 6};
+    const int values[]{-1, -2, -3, -4, -5};
+    sc::vector<int> vec{0, 1, 2, 3, 4, 5};
+    vec.reserve(16);
+    const int *storage = vec.data();
+    vec.insert_batch(std::begin(positions), std::end(positions), std::begin(values));
+    EXPECT_EQ(vec, (sc::vector<int>{-1, 0, 1, -2, -3, 2, 3, 4, -4, 5, -5}));
+    EXPECT_TRUE(vec.data() == storage);
+
+    // Same edits on a non-relocatable type, growing the storage once.
+    sc::vector<std::string> words{"a", "b", "c", "d", "e", "f"};
+    sc::vector<std::string> expected{words};
+    const std::string inserted[]{"v", "w", "x", "y", "z"};
+    for (int j{4}; j >= 0; --j)
+      expected.insert(expected.begin() + positions[j], inserted[j]);
+    words.insert_batch(std::begin(positions), std::end(positions), std::begin(inserted));
+    EXPECT_EQ(words, expected);
+
+    const int dropped[]{0, 3, 4, 10};
+    EXPECT_EQ(vec.erase_indices(std::begin(dropped), std::end(dropped)), 4u);
+    EXPECT_EQ(vec, (sc::vector<int>{0, 1, 2, 3, 4, -4, 5}));
+    EXPECT_EQ(words.erase_indices(std::begin(dropped), std::end(dropped)), 4u);
+    EXPECT_EQ(words, (sc::vector<std::string>{"a", "b", "c", "d", "e", "y", "f"}));
+
+    const bool mask[]{true, false, false, true, false, true, true};
+    EXPECT_EQ(words.erase_mask(std::begin(mask)), 4u);
+    EXPECT_EQ(words, (sc::vector<std::string>{"b", "c", "e"}));
+
+    // Bad batches are rejected before anything is touched.
+    const int unsorted[]{3, 1};
+    bool thrown{false};
+    try {
+      vec.erase_indices(std::begin(unsorted), std::end(unsorted));
+    } catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    thrown = false;
+    const std::size_t past_end[]{vec.size() + 1};
+    try {
+      vec.insert_batch(std::begin(past_end), std::end(past_end), std::begin(values));
+    } catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(vec.size(), 7u);
+
+    Tracked::reset();
+    {
+      sc::vector<Tracked> tracked;
+      for (int i{0}; i < 50; ++i)
+        tracked.push_back(Tracked{i});
+      const Tracked more[]{Tracked{100}, Tracked{200}};
+      const int at[]{10, 50};
+      tracked.insert_batch(std::begin(at), std::end(at), std::begin(more));
+      EXPECT_EQ(tracked[10].value, 100);
+      EXPECT_EQ(tracked[51].value, 200);
+      const int gone[]{0, 10, 51};
+      tracked.erase_indices(std::begin(gone), std::end(gone));
+      EXPECT_EQ(tracked.size(), 49u);
+      EXPECT_EQ(Tracked::alive, 49 + 2);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if BATCH_ROLLBACK
+  {
+    BEGIN_TEST(tm, "BatchRollback", "insert_batch() whose 2nd copy throws");
+    Fragile::alive = 0;
+    {
+      // The last element and the 3rd value move past the end, then the 2nd throws.
+      const std::size_t positions[]{2, 4, 4};
+      const Fragile values[]{Fragile{10}, Fragile{11}, Fragile{12}};
+      sc::vector<Fragile> vec;
+      vec.reserve(16);
+      for (int i{0}; i < 5; ++i)
+        vec.emplace_back(i);
+      Fragile::copies_left = 1;
+      bool thrown{false};
+      try {
+        vec.insert_batch(std::begin(positions), std::end(positions), std::begin(values));
+      } catch (const std::runtime_error &) {
+        thrown = true;
+      }
+      EXPECT_TRUE(thrown);
+      // Basic guarantee: the size is kept and nothing leaks.
+      EXPECT_EQ(vec.size(), 5u);
+      EXPECT_EQ(Fragile::alive, 3 + 5);
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+    {
+      const std::size_t positions[]{1, 3, 3};
+      const RelocFragile values[]{RelocFragile{10}, RelocFragile{11}, RelocFragile{12}};
+      sc::vector<RelocFragile> vec;
+      vec.reserve(16);
+      for (int i{0}; i < 5; ++i)
+        vec.emplace_back(i);
+      Fragile::copies_left = 1;
+      bool thrown{false};
+      try {
+        vec.insert_batch(std::begin(positions), std::end(positions), std::begin(values));
+      } catch (const std::runtime_error &) {
+        thrown = true;
+      }
+      EXPECT_TRUE(thrown);
+      // Relocatable: every element is kept, along with the value inserted
+      // (the values go in from the back).
+      const int expected[]{0, 1, 2, 12, 3, 4};
+      EXPECT_EQ(vec.size(), 6u);
+      for (std::size_t i{0}; i < vec.size(); ++i)
+        EXPECT_EQ(vec[i].value, expected[i]);
+      EXPECT_EQ(Fragile::alive, 3 + 6);
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
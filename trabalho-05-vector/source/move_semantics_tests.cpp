@@ -1,5 +1,7 @@
+#include <array>
 #include <cstddef>
 #include<iostream>
+#include <string>
 #include<vector>
 
 #include "tm/test_manager.h"
@@ -17,14 +19,57 @@
 // =============================================================
 
 // Move Ctro.
-#define MOVE_CTRO NO
+#define MOVE_CTRO YES
 // Move assignment operator.
-#define MOVE_ASSIGNMENT NO
+#define MOVE_ASSIGNMENT YES
+// Reallocation moves the elements instead of copying them.
+#define MOVE_ON_GROWTH YES
+// Reallocation copies the elements whose move ctor may throw.
+#define COPY_IF_MOVE_THROWS YES
 // Emplace back operator.
-#define EMPLACE_BACK_INT NO
+#define EMPLACE_BACK_INT YES
 // Emplace back operator.
-#define EMPLACE_BACK_STRING NO
+#define EMPLACE_BACK_STRING YES
+// Emplace back a record built from several fields.
+#define EMPLACE_BACK_RECORD YES
+// Emplace in the middle of the vector.
+#define EMPLACE_POS YES
+// push_back/insert of rvalues move the argument in.
+#define PUSH_BACK_RVALUE YES
 
+namespace {
+/// Counts copies and moves; `NoThrow` tells whether the move ctor is noexcept.
+template <bool NoThrow> struct Counted {
+    static int copies; //!< Copy ctor calls.
+    static int moves;  //!< Move ctor calls.
+    std::string value;
+
+    Counted( std::string v ) : value{ std::move(v) } {}
+    Counted( const Counted& other ) : value{ other.value } { ++copies; }
+    Counted( Counted&& other ) noexcept(NoThrow) : value{ std::move(other.value) } { ++moves; }
+    Counted& operator=( const Counted& ) = default;
+    Counted& operator=( Counted&& ) = default;
+
+    static void reset() { copies = moves = 0; }
+};
+template <bool NoThrow> int Counted<NoThrow>::copies = 0;
+template <bool NoThrow> int Counted<NoThrow>::moves = 0;
+
+/// A record built from several fields, that can only be built in place.
+struct Record {
+    static int ctor_calls; //!< Calls to the field-wise ctor.
+    int id;
+    std::string name;
+    double score;
+
+    Record( int i, std::string n, double s ) : id{i}, name{ std::move(n) }, score{s} { ++ctor_calls; }
+    Record( const Record& ) = delete;
+    Record( Record&& ) noexcept = default;
+    Record& operator=( const Record& ) = delete;
+    Record& operator=( Record&& ) noexcept = default;
+};
+int Record::ctor_calls = 0;
+} // namespace
 
 void run_move_semantics_tests( void )
 {
@@ -70,6 +115,46 @@ void run_move_semantics_tests( void )
     }
 #endif
 
+#if MOVE_ON_GROWTH
+    {
+        BEGIN_TEST(tm, "MoveOnGrowth", "reserve() moves nothrow-movable elements");
+        using Elem = Counted<true>;
+        which_lib::vector<Elem> vec;
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.push_back( Elem{ std::to_string(i) } );
+
+        Elem::reset();
+        vec.reserve( 1000 );
+        EXPECT_EQ( Elem::copies, 0 );
+        EXPECT_EQ( Elem::moves, 100 );
+        vec.insert( vec.begin(), Elem{ "front" } );
+        EXPECT_EQ( Elem::copies, 0 );
+        vec.shrink_to_fit();
+        EXPECT_EQ( Elem::copies, 0 );
+
+        EXPECT_EQ( vec[0].value, std::string{"front"} );
+        for( auto i{1u} ; i < vec.size() ; ++i )
+            EXPECT_EQ( vec[i].value, std::to_string(i-1) );
+    }
+#endif
+
+#if COPY_IF_MOVE_THROWS
+    {
+        BEGIN_TEST(tm, "CopyIfMoveThrows", "reserve() copies when the move ctor may throw");
+        using Elem = Counted<false>;
+        which_lib::vector<Elem> vec;
+        for ( auto i{0} ; i < 10 ; ++i )
+            vec.push_back( Elem{ std::to_string(i) } );
+
+        Elem::reset();
+        vec.reserve( 100 );
+        EXPECT_EQ( Elem::copies, 10 );
+        EXPECT_EQ( Elem::moves, 0 );
+        for( auto i{0u} ; i < vec.size() ; ++i )
+            EXPECT_EQ( vec[i].value, std::to_string(i) );
+    }
+#endif
+
 #if EMPLACE_BACK_INT
     {
         BEGIN_TEST(tm, "Emplace back integer", "vec<int>.emplace_back(value)");
@@ -137,6 +222,64 @@ void run_move_semantics_tests( void )
             EXPECT_EQ( values_s[i], vec[i] );
     }
 #endif
+#if EMPLACE_BACK_RECORD
+    {
+        BEGIN_TEST(tm, "Emplace back record", "vec<Record>.emplace_back(id, name, score)");
+        which_lib::vector<Record> vec;
+        Record::ctor_calls = 0;
+
+        for ( auto i{0} ; i < 20 ; ++i )
+        {
+            auto& rec = vec.emplace_back( i, "rec" + std::to_string(i), i * 0.5 );
+            EXPECT_EQ( rec.id, i );
+        }
+        EXPECT_EQ( Record::ctor_calls, 20 );
+        EXPECT_EQ( vec.size(), 20 );
+        for ( auto i{0u} ; i < vec.size() ; ++i )
+        {
+            EXPECT_EQ( vec[i].id, (int)i );
+            EXPECT_EQ( vec[i].name, "rec" + std::to_string(i) );
+            EXPECT_EQ( vec[i].score, i * 0.5 );
+        }
+    }
+#endif
+
+#if EMPLACE_POS
+    {
+        BEGIN_TEST(tm, "Emplace at position", "vec.emplace(pos, args...)");
+        which_lib::vector<std::string> vec{ "a", "b", "c" };
+
+        auto it = vec.emplace( vec.begin()+1, 3, 'x' );
+        EXPECT_EQ( *it, std::string{"xxx"} );
+        vec.emplace( vec.end(), "z" );
+        vec.emplace( vec.begin(), vec.back() ); // Argument lives inside the vector.
+        vec.shrink_to_fit();
+        vec.emplace( vec.begin()+2, vec[0] ); // Argument lives inside a full vector.
+
+        which_lib::vector<std::string> expected{ "z", "a", "z", "xxx", "b", "c", "z" };
+        EXPECT_EQ( vec, expected );
+    }
+#endif
+
+#if PUSH_BACK_RVALUE
+    {
+        BEGIN_TEST(tm, "Push back rvalue", "vec.push_back(std::move(x)), vec.insert(pos, std::move(x))");
+        using Elem = Counted<true>;
+        which_lib::vector<Elem> vec;
+        vec.reserve( 10 );
+
+        Elem::reset();
+        Elem x{ "x" };
+        vec.push_back( std::move(x) );
+        vec.push_back( Elem{ "y" } );
+        vec.insert( vec.begin(), Elem{ "w" } );
+        EXPECT_EQ( Elem::copies, 0 );
+        EXPECT_EQ( vec[0].value, std::string{"w"} );
+        EXPECT_EQ( vec[1].value, std::string{"x"} );
+        EXPECT_EQ( vec[2].value, std::string{"y"} );
+    }
+#endif
+
     tm.summary();
     std::cout << "\n\n";
 }
@@ -0,0 +1,229 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "reclaimer.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Tests for the storage reclamation policies of sc::vector
+// =============================================================
+
+// The default policy destroys and frees on the spot.
+#define RECLAIM_IMMEDIATE YES
+// background<> destroys the elements on the reclaimer thread.
+#define RECLAIM_BACKGROUND YES
+// Areas below the threshold are released on the spot.
+#define RECLAIM_THRESHOLD YES
+// Growth and assignment hand their old areas over as well.
+#define RECLAIM_GROWTH YES
+// A full queue makes submit() run the job on the caller.
+#define RECLAIM_BOUNDED_QUEUE YES
+// In overflow::block mode a full queue makes submit() wait instead.
+#define RECLAIM_BLOCK_WHEN_FULL YES
+
+namespace {
+/// Element type that records where it was destroyed.
+struct Tracked {
+  static std::atomic<long> alive;             //!< Objects currently alive.
+  static std::atomic<long> foreign_dtors;     //!< Destructors run off the main thread.
+  static std::thread::id main_thread;         //!< Thread that runs the tests.
+  int value;
+
+  Tracked(int v = 0) : value{v} { ++alive; }
+  Tracked(const Tracked &other) : value{other.value} { ++alive; }
+  Tracked &operator=(const Tracked &other) = default;
+  ~Tracked() {
+    --alive;
+    if (std::this_thread::get_id() != main_thread) { ++foreign_dtors; }
+  }
+
+  static void reset() {
+    alive = 0;
+    foreign_dtors = 0;
+    main_thread = std::this_thread::get_id();
+  }
+};
+std::atomic<long> Tracked::alive{0};
+std::atomic<long> Tracked::foreign_dtors{0};
+std::thread::id Tracked::main_thread{};
+
+/// Bytes handed out and not yet returned, from any thread.
+std::atomic<long> live_bytes{0};
+
+/// std::allocator that keeps live_bytes up to date.
+template <typename T> struct counting_allocator {
+  using value_type = T;
+  counting_allocator() = default;
+  template <typename U> counting_allocator(const counting_allocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    live_bytes += n * sizeof(T);
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    live_bytes -= n * sizeof(T);
+    std::allocator<T>{}.deallocate(p, n);
+  }
+  friend bool operator==(const counting_allocator &, const counting_allocator &) { return true; }
+  friend bool operator!=(const counting_allocator &, const counting_allocator &) { return false; }
+};
+
+template <typename T>
+using deferred_vector = sc::vector<T, std::allocator<T>, sc::growth::doubling, sc::reclaim::background<0>>;
+} // namespace
+
+void run_reclaim_tests(void) {
+  TestManager tm{"Reclamation policy testing"};
+
+#if RECLAIM_IMMEDIATE
+  {
+    BEGIN_TEST(tm, "ReclaimImmediate", "sc::vector<Tracked> goes out of scope");
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec(1000);
+      EXPECT_EQ(Tracked::alive.load(), 1000);
+    }
+    EXPECT_EQ(Tracked::alive.load(), 0);
+    EXPECT_EQ(Tracked::foreign_dtors.load(), 0);
+  }
+#endif
+
+#if RECLAIM_BACKGROUND
+  {
+    BEGIN_TEST(tm, "ReclaimBackground", "vector<Tracked, ..., background<0>>");
+    Tracked::reset();
+    {
+      deferred_vector<Tracked> vec(100'000);
+      EXPECT_EQ(Tracked::alive.load(), 100'000);
+    }
+    sc::reclaim::background<0>::flush();
+    EXPECT_EQ(Tracked::alive.load(), 0);
+    EXPECT_EQ(Tracked::foreign_dtors.load(), 100'000);
+  }
+#endif
+
+#if RECLAIM_THRESHOLD
+  {
+    BEGIN_TEST(tm, "ReclaimThreshold", "background<1 MiB> with a small vector");
+    Tracked::reset();
+    {
+      sc::vector<Tracked, std::allocator<Tracked>, sc::growth::doubling,
+                 sc::reclaim::background<>> vec(10);
+    }
+    // Released on the spot, without waiting for any flush.
+    EXPECT_EQ(Tracked::alive.load(), 0);
+    EXPECT_EQ(Tracked::foreign_dtors.load(), 0);
+  }
+#endif
+
+#if RECLAIM_GROWTH
+  {
+    BEGIN_TEST(tm, "ReclaimGrowth", "push_back(), shrink_to_fit(), operator=");
+    using policy = sc::reclaim::background<0>;
+    Tracked::reset();
+    live_bytes = 0;
+    {
+      sc::vector<Tracked, counting_allocator<Tracked>, sc::growth::doubling, policy> vec;
+      for (int i{0}; i < 5000; ++i)
+        vec.push_back(Tracked{i});
+      vec.erase(vec.begin() + 10, vec.end());
+      vec.shrink_to_fit();
+      policy::flush();
+      // Only the current area is left, with its 10 elements.
+      EXPECT_EQ(live_bytes.load(), long(10 * sizeof(Tracked)));
+      EXPECT_EQ(Tracked::alive.load(), 10);
+      EXPECT_EQ(vec[9].value, 9);
+
+      vec = decltype(vec){Tracked{1}, Tracked{2}};
+      policy::flush();
+      EXPECT_EQ(Tracked::alive.load(), 2);
+      EXPECT_EQ(live_bytes.load(), long(2 * sizeof(Tracked)));
+    }
+    policy::flush();
+    EXPECT_EQ(live_bytes.load(), 0);
+    EXPECT_EQ(Tracked::alive.load(), 0);
+  }
+#endif
+
+#if RECLAIM_BOUNDED_QUEUE
+  {
+    BEGIN_TEST(tm, "ReclaimBoundedQueue", "reclaimer{2} with a stalled worker");
+    sc::reclaimer reclaimer{2};
+    std::atomic<bool> go{false};
+    std::atomic<int> done{0};
+    std::atomic<int> on_caller{0};
+    const auto caller = std::this_thread::get_id();
+    auto job = [&] {
+      while (!go) { std::this_thread::yield(); }
+      if (std::this_thread::get_id() == caller) { ++on_caller; }
+      ++done;
+    };
+    // The first job stalls the worker; two more fill the queue.
+    reclaimer.submit(job);
+    while (reclaimer.pending() != 0) { std::this_thread::yield(); }
+    reclaimer.submit(job);
+    reclaimer.submit(job);
+    EXPECT_EQ(reclaimer.pending(), 2u);
+    go = true;
+    reclaimer.flush();
+    EXPECT_EQ(done.load(), 3);
+    EXPECT_EQ(on_caller.load(), 0);
+    EXPECT_EQ(reclaimer.pending(), 0u);
+
+    go = false;
+    reclaimer.submit(job);
+    while (reclaimer.pending() != 0) { std::this_thread::yield(); }
+    reclaimer.submit(job);
+    reclaimer.submit(job);
+    std::thread release{[&] {
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+      go = true;
+    }};
+    reclaimer.submit(job); // Full: runs here, once `go` is set.
+    release.join();
+    EXPECT_EQ(on_caller.load(), 1);
+    reclaimer.flush();
+    EXPECT_EQ(done.load(), 7);
+  }
+#endif
+
+#if RECLAIM_BLOCK_WHEN_FULL
+  {
+    BEGIN_TEST(tm, "ReclaimBlockWhenFull", "reclaimer{1, overflow::block} with a stalled worker");
+    sc::reclaimer reclaimer{1, sc::reclaimer::overflow::block};
+    EXPECT_TRUE(reclaimer.overflow_mode() == sc::reclaimer::overflow::block);
+    std::atomic<bool> go{false};
+    std::atomic<int> done{0};
+    std::atomic<int> on_caller{0};
+    const auto caller = std::this_thread::get_id();
+    auto job = [&] {
+      while (!go) { std::this_thread::yield(); }
+      if (std::this_thread::get_id() == caller) { ++on_caller; }
+      ++done;
+    };
+    reclaimer.submit(job);
+    while (reclaimer.pending() != 0) { std::this_thread::yield(); }
+    reclaimer.submit(job);
+    std::thread release{[&] {
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+      go = true;
+    }};
+    reclaimer.submit(job); // Full: waits for room, then queues it.
+    release.join();
+    reclaimer.flush();
+    EXPECT_EQ(done.load(), 3);
+    EXPECT_EQ(on_caller.load(), 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,189 @@
+#ifndef _RECLAIMER_H_
+#define _RECLAIMER_H_
+
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <deque>              // std::deque
+#include <functional>         // std::function
+#include <mutex>              // std::mutex, std::unique_lock
+#include <thread>             // std::thread
+
+#include "vector.h" // sc::reclaim
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Background thread that runs the reclamation jobs of released storage.
+/*!
+ * A job destroys the elements of a storage area and deallocates it (see
+ * sc::reclaim). The reclaimer runs the jobs, in submission order, on a
+ * thread of its own, so the thread that released the storage does not pay
+ * for the destructors, `free` or `munmap`.
+ *
+ * At most `max_pending()` jobs wait in the queue, which bounds the memory
+ * held by released but not yet reclaimed areas. What submit() does when the
+ * queue is full is the reclaimer's overflow_mode(): run the job on the
+ * calling thread (the default), or wait until the worker makes room. Should
+ * the queue itself fail to allocate, the job runs on the calling thread in
+ * either mode.
+ *
+ * flush() waits until every job submitted so far has run, e.g. before
+ * measuring memory use or before tearing down an allocator the jobs use.
+ */
+class reclaimer {
+public:
+  /// Queue depth of the global() reclaimer.
+  static constexpr std::size_t default_max_pending = 64;
+
+  /// What submit() does with a job when the queue is full.
+  enum class overflow {
+    run_inline, //!< Run it on the calling thread: no wait, but its full cost.
+    block       //!< Wait until the worker has taken a job from the queue.
+  };
+
+  /// Starts the background thread.
+  explicit reclaimer(std::size_t max_pending = default_max_pending,
+                     overflow when_full = overflow::run_inline)
+      : m_max_pending{max_pending}, m_overflow{when_full}, m_thread{[this] { run(); }} {}
+
+  reclaimer(const reclaimer &) = delete;
+  reclaimer &operator=(const reclaimer &) = delete;
+
+  /// Runs the pending jobs, then stops the background thread.
+  ~reclaimer() {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_stop = true;
+    }
+    m_work.notify_one();
+    m_thread.join();
+  }
+
+  /*!
+   * The reclaimer used by sc::reclaim::background. It is never destroyed, so
+   * vectors with static storage duration may still release their storage
+   * while the program exits; jobs still pending at exit are dropped.
+   */
+  static reclaimer &global() {
+    static reclaimer *instance = new reclaimer{};
+    return *instance;
+  }
+
+  /// Queues `job`; when the queue is full, runs it right away or waits (see overflow_mode()).
+  template <typename Job> void submit(Job &&job) noexcept {
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      // A job that releases storage itself must not wait for its own thread.
+      if (m_overflow == overflow::block && std::this_thread::get_id() != m_thread.get_id()) {
+        m_room.wait(lock, [this] { return m_queue.size() < m_max_pending; });
+      }
+      if (m_queue.size() < m_max_pending) {
+        try {
+          m_queue.emplace_back(job);
+          m_work.notify_one();
+          return;
+        } catch (...) {
+          // Out of memory for the queue: reclaim on this thread.
+        }
+      }
+    }
+    job();
+  }
+
+  /// Blocks until every job submitted so far has run.
+  void flush() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+  }
+
+  /// Number of jobs waiting in the queue.
+  [[nodiscard]] std::size_t pending() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_queue.size();
+  }
+
+  /// Most jobs that may wait in the queue.
+  [[nodiscard]] std::size_t max_pending() const { return m_max_pending; }
+
+  /// What submit() does when the queue is full.
+  [[nodiscard]] overflow overflow_mode() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_overflow;
+  }
+
+  /// Changes overflow_mode(), e.g. of global() at program start.
+  void set_overflow_mode(overflow when_full) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_overflow = when_full;
+  }
+
+private:
+  /// Body of the background thread.
+  void run() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (true) {
+      m_work.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+      if (m_queue.empty()) { return; } // Stopping, and nothing left to do.
+      std::function<void()> job = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_room.notify_one();
+      m_busy = true;
+      lock.unlock();
+      job();
+      job = nullptr; // Whatever the job captured goes away off the lock too.
+      lock.lock();
+      m_busy = false;
+      if (m_queue.empty()) { m_idle.notify_all(); }
+    }
+  }
+
+  mutable std::mutex m_mutex;              //!< Guards everything below.
+  std::condition_variable m_work;          //!< Signals a new job (or stop).
+  std::condition_variable m_idle;          //!< Signals an empty queue.
+  std::condition_variable m_room;          //!< Signals a job taken from the queue.
+  std::deque<std::function<void()>> m_queue; //!< Jobs waiting to run.
+  std::size_t m_max_pending;               //!< Most jobs in m_queue.
+  overflow m_overflow;                     //!< What submit() does when m_queue is full.
+  bool m_busy{false};                      //!< A job is running.
+  bool m_stop{false};                      //!< The destructor was called.
+  std::thread m_thread;                    //!< Runs the jobs; started last.
+};
+
+namespace reclaim {
+
+/// Hands storage areas of at least `MinBytes` bytes to reclaimer::global().
+/*!
+ * \code
+ * using big_vector = sc::vector<Node, std::allocator<Node>, sc::growth::doubling,
+ *                               sc::reclaim::background<>>;
+ * \endcode
+ *
+ * The allocator must be usable from another thread: a job runs on a copy of
+ * it. Smaller areas are released on the spot, where the cost is low and a
+ * queue round trip would dominate.
+ *
+ * Deferring is best effort: when the reclaimer's queue is full the job runs
+ * on the releasing thread, paying the very cost it was meant to avoid. A
+ * thread that must never pay it can make the global reclaimer wait for room
+ * instead, `sc::reclaimer::global().set_overflow_mode(sc::reclaimer::overflow::block)`,
+ * trading that cost for a (usually shorter) wait.
+ *
+ * A job holds a copy of the allocator, not the memory resource or arena
+ * behind it. Before such a resource is reset or destroyed (e.g. an
+ * sc::pmr::arena_resource), call flush() so that no pending job still
+ * deallocates into it.
+ */
+template <std::size_t MinBytes = (std::size_t{1} << 20)> struct background {
+  static bool defer(std::size_t bytes) { return bytes >= MinBytes; }
+  template <typename Job> static void submit(Job &&job) {
+    reclaimer::global().submit(std::forward<Job>(job));
+  }
+  /// Waits until every area released so far has been reclaimed.
+  static void flush() { reclaimer::global().flush(); }
+};
+
+} // namespace reclaim.
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,489 @@
+#ifndef _RING_VECTOR_H_
+#define _RING_VECTOR_H_
+
+#include "index_iterator.h" // sc::index_iterator
+#include "vector.h"         // sc::detail, sc::is_trivially_relocatable
+
+/// Sequence container namespace.
+namespace sc {
+
+/// What a full ring_vector does with a new element.
+enum class ring_mode {
+  bounded,  //!< Refuse it: push_*() throws std::length_error.
+  overwrite //!< Make room by dropping the element at the opposite end.
+};
+
+/// Fixed-capacity circular buffer.
+/*!
+ * sc::ring_vector keeps up to capacity() elements in a storage area that is
+ * allocated once, at construction. The logical sequence starts anywhere in
+ * that area and wraps around its end, so pushing or popping at either end is
+ * O(1) and never moves the other elements, which makes it a good fit for
+ * rolling windows of the last N samples.
+ *
+ * In ring_mode::overwrite a push into a full ring drops the element at the
+ * opposite end (the oldest one, for push_back()). In ring_mode::bounded it
+ * throws std::length_error instead.
+ *
+ * The elements occupy at most two contiguous runs of memory,
+ * first_segment() and second_segment(), so bulk copies and vectorized loops
+ * can still work on flat arrays. linearize() rotates the elements into a
+ * single run when one pointer is needed.
+ *
+ * \tparam T The type of the elements.
+ * \tparam Allocator The allocator used to acquire the storage area.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class ring_vector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Allocator::value_type must be the same as T");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T *>,
+                "sc::ring_vector requires an allocator with raw pointers");
+
+  //=== Aliases
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using const_pointer = const value_type *; //!< Pointer to a const value.
+  using reference = value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value stored in the container.
+  using iterator = index_iterator<ring_vector, value_type>; //!< The iterator.
+  using const_iterator = index_iterator<const ring_vector, const value_type>; //!< The const_iterator.
+  using allocator_type = Allocator; //!< The allocator type.
+
+  /// A contiguous run of elements.
+  template <typename P> struct basic_segment {
+    P data;         //!< First element of the run.
+    size_type size; //!< Number of elements in the run.
+    P begin() const { return data; }
+    P end() const { return data + size; }
+  };
+  using segment = basic_segment<pointer>;             //!< Mutable run.
+  using const_segment = basic_segment<const_pointer>; //!< Read-only run.
+
+  //=== [I] SPECIAL MEMBERS
+/**
+ * @brief Constructs an empty ring with room for `capacity` elements.
+ *
+ * @param capacity The fixed capacity.
+ * @param mode What a push into a full ring does.
+ * @param alloc The allocator to use.
+ */
+explicit ring_vector(size_type capacity, ring_mode mode = ring_mode::bounded,
+                     const Allocator &alloc = Allocator())
+  : m_head{0}, m_size{0}, m_capacity{capacity}, m_buffer{nullptr}, m_mode{mode}, m_alloc{alloc} {
+  if (capacity != 0){ m_buffer = alloc_traits::allocate(m_alloc, capacity); }
+}
+
+/**
+ * @brief Copy constructor; the copy is linearized (its front is slot 0).
+ *
+ * @param other The ring to copy from.
+ */
+ring_vector(const ring_vector &other)
+  : ring_vector(other.m_capacity, other.m_mode,
+                alloc_traits::select_on_container_copy_construction(other.m_alloc)) {
+  for (const auto &value : other){ emplace_back(value); }
+}
+
+/**
+ * @brief Move constructor: takes over the storage of `other` in O(1).
+ *
+ * `other` is left empty, with capacity 0.
+ *
+ * @param other The ring to move from.
+ */
+ring_vector(ring_vector &&other) noexcept
+  : m_head{other.m_head}, m_size{other.m_size}, m_capacity{other.m_capacity},
+    m_buffer{other.m_buffer}, m_mode{other.m_mode}, m_alloc{std::move(other.m_alloc)} {
+  other.m_buffer = nullptr;
+  other.m_head = other.m_size = other.m_capacity = 0;
+}
+
+/**
+ * @brief Destructor.
+ */
+~ring_vector() { release(); }
+
+/**
+ * @brief Copy assignment operator: copies the elements, capacity and mode.
+ *
+ * @param rhs The ring to copy from.
+ * @return Reference to the modified ring.
+ */
+ring_vector &operator=(const ring_vector &rhs) {
+  if (this == &rhs) { return *this; }
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+    if (m_alloc != rhs.m_alloc) { release(); }
+    m_alloc = rhs.m_alloc;
+  }
+  refill(rhs.begin(), rhs.end(), rhs.m_capacity, rhs.m_mode);
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ *
+ * Takes over the storage of `rhs` when our allocator can release it;
+ * otherwise the elements are moved one by one. `rhs` is left empty.
+ *
+ * @param rhs The ring to move from.
+ * @return Reference to the modified ring.
+ */
+ring_vector &operator=(ring_vector &&rhs) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value) {
+  if (this == &rhs) { return *this; }
+  if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+    if (m_alloc != rhs.m_alloc) {
+      refill(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()),
+             rhs.m_capacity, rhs.m_mode);
+      rhs.clear();
+      return *this;
+    }
+  }
+  release();
+  if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+    m_alloc = std::move(rhs.m_alloc);
+  }
+  m_head = rhs.m_head;
+  m_size = rhs.m_size;
+  m_capacity = rhs.m_capacity;
+  m_buffer = rhs.m_buffer;
+  m_mode = rhs.m_mode;
+  rhs.m_buffer = nullptr;
+  rhs.m_head = rhs.m_size = rhs.m_capacity = 0;
+  return *this;
+}
+
+/// Returns a copy of the allocator associated with the ring.
+allocator_type get_allocator() const { return m_alloc; }
+
+  //=== [II] ITERATORS
+iterator begin() { return iterator{this, 0}; }
+iterator end() { return iterator{this, m_size}; }
+const_iterator begin() const { return const_iterator{this, 0}; }
+const_iterator end() const { return const_iterator{this, m_size}; }
+const_iterator cbegin() const { return begin(); }
+const_iterator cend() const { return end(); }
+
+  // [III] Capacity
+[[nodiscard]] bool full() const { return m_size == m_capacity; }
+[[nodiscard]] size_type size() const { return m_size; }
+[[nodiscard]] size_type capacity() const { return m_capacity; }
+[[nodiscard]] bool empty() const { return m_size == 0; }
+[[nodiscard]] ring_mode mode() const { return m_mode; }
+void set_mode(ring_mode mode) { m_mode = mode; }
+
+  // [IV] Modifiers
+void clear(){
+  for (size_type i{0}; i < m_size; ++i){ alloc_traits::destroy(m_alloc, slot(i)); }
+  m_head = m_size = 0;
+}
+
+/**
+ * @brief Inserts an element at the end.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the ring is full in bounded mode.
+ */
+void push_back(const_reference value){ emplace_back(value); }
+
+/**
+ * @brief Inserts an element at the end, moving it in.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the ring is full in bounded mode.
+ */
+void push_back(value_type &&value){ emplace_back(std::move(value)); }
+
+/**
+ * @brief Inserts an element at the beginning.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the ring is full in bounded mode.
+ */
+void push_front(const_reference value){ emplace_front(value); }
+
+/**
+ * @brief Inserts an element at the beginning, moving it in.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the ring is full in bounded mode.
+ */
+void push_front(value_type &&value){ emplace_front(std::move(value)); }
+
+/**
+ * @brief Constructs an element in place at the end, in O(1).
+ *
+ * In overwrite mode a full ring drops its front (oldest) element.
+ *
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ * @throws std::length_error if the ring is full in bounded mode.
+ */
+template <typename... Args>
+reference emplace_back(Args &&...args){
+  if (full()){
+    check_overwrite();
+    // The oldest slot becomes the newest one.
+    *slot(0) = value_type(std::forward<Args>(args)...);
+    m_head = wrap(m_head + 1);
+  } else {
+    alloc_traits::construct(m_alloc, slot(m_size), std::forward<Args>(args)...);
+    ++m_size;
+  }
+  return back();
+}
+
+/**
+ * @brief Constructs an element in place at the beginning, in O(1).
+ *
+ * In overwrite mode a full ring drops its back (newest) element.
+ *
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ * @throws std::length_error if the ring is full in bounded mode.
+ */
+template <typename... Args>
+reference emplace_front(Args &&...args){
+  if (full()){
+    check_overwrite();
+    // The newest slot becomes the front.
+    *slot(m_size - 1) = value_type(std::forward<Args>(args)...);
+    m_head = wrap(m_head + m_capacity - 1);
+  } else {
+    pointer dest = m_buffer + wrap(m_head + m_capacity - 1);
+    alloc_traits::construct(m_alloc, dest, std::forward<Args>(args)...);
+    m_head = dest - m_buffer;
+    ++m_size;
+  }
+  return front();
+}
+
+/**
+ * @brief Removes the last element, in O(1).
+ *
+ * @throws std::length_error if the ring is empty.
+ */
+void pop_back(){
+  if(empty()){throw std::length_error("POP_BACK(EMPTY)\n");}
+  alloc_traits::destroy(m_alloc, slot(--m_size));
+}
+
+/**
+ * @brief Removes the first element, in O(1).
+ *
+ * @throws std::length_error if the ring is empty.
+ */
+void pop_front(){
+  if(empty()){throw std::length_error("POP_FRONT(EMPTY)\n");}
+  alloc_traits::destroy(m_alloc, slot(0));
+  m_head = wrap(m_head + 1);
+  --m_size;
+}
+
+/**
+ * @brief Rotates the elements so they occupy one contiguous run from slot 0.
+ *
+ * @return A pointer to the first element.
+ */
+pointer linearize(){
+  if (m_head == 0){ return m_buffer; }
+  if (m_head + m_size <= m_capacity){
+    // Already contiguous: slide it down.
+    move_block(m_head, m_size, 0);
+  } else if (full()){
+    std::rotate(m_buffer, m_buffer + m_head, m_buffer + m_capacity);
+  } else {
+    // Close the raw gap between the runs, so the rotation only sees live
+    // slots, then slide the result down.
+    const size_type wrapped = m_head + m_size - m_capacity;
+    const size_type gap = m_head - wrapped;
+    move_block(0, wrapped, gap);
+    std::rotate(m_buffer + gap, m_buffer + m_head, m_buffer + m_capacity);
+    move_block(gap, m_size, 0);
+  }
+  m_head = 0;
+  return m_buffer;
+}
+
+  // [V] Element access
+/// The first run of elements, starting at the front.
+segment first_segment() { return {m_buffer + m_head, first_run()}; }
+/// The second run of elements (empty unless the sequence wraps around).
+segment second_segment() { return {m_buffer, m_size - first_run()}; }
+const_segment first_segment() const { return {m_buffer + m_head, first_run()}; }
+const_segment second_segment() const { return {m_buffer, m_size - first_run()}; }
+
+const_reference back() const {
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *slot(m_size - 1);
+}
+
+const_reference front() const{
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *slot(0);
+}
+
+reference back(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *slot(m_size - 1);
+}
+
+reference front(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *slot(0);
+}
+
+const_reference operator[](size_type idx) const { return *slot(idx); }
+reference operator[](size_type idx) { return *slot(idx); }
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the ring is empty.
+ * @throws std::out_of_range if pos is not within the range of the ring.
+ */
+const_reference at(size_type pos) const {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_size) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return *slot(pos);
+}
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the ring is empty.
+ * @throws std::out_of_range if pos is not within the range of the ring.
+ */
+reference at(size_type pos) {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_size) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return *slot(pos);
+}
+
+  // [VII] Friend functions.
+friend std::ostream &operator<<(std::ostream &os, const ring_vector &ring) {
+  os << "{ ";
+  for (const auto &value : ring) {
+    os << value << " ";
+  }
+  os << "| }, m_head=" << ring.m_head << ", m_size=" << ring.m_size
+     << ", m_capacity=" << ring.m_capacity;
+  return os;
+}
+
+friend void swap(ring_vector &first, ring_vector &second) noexcept {
+  using std::swap;
+  if constexpr (alloc_traits::propagate_on_container_swap::value) {
+    swap(first.m_alloc, second.m_alloc);
+  }
+  swap(first.m_head, second.m_head);
+  swap(first.m_size, second.m_size);
+  swap(first.m_capacity, second.m_capacity);
+  swap(first.m_buffer, second.m_buffer);
+  swap(first.m_mode, second.m_mode);
+}
+
+private:
+/// Whether elements may be moved around as raw bytes.
+static constexpr bool relocatable = is_trivially_relocatable_v<value_type> &&
+                                    detail::is_plain_construct_allocator<Allocator>::value;
+
+/// Maps a physical index in `[0, 2 * capacity)` into the storage area.
+size_type wrap(size_type idx) const { return idx >= m_capacity ? idx - m_capacity : idx; }
+
+/// Slot of the logical element `idx`.
+pointer slot(size_type idx) { return m_buffer + wrap(m_head + idx); }
+const_pointer slot(size_type idx) const { return m_buffer + wrap(m_head + idx); }
+
+/// Number of elements between the front and the end of the storage area.
+size_type first_run() const { return std::min(m_size, m_capacity - m_head); }
+
+void check_overwrite() const {
+  if (m_mode != ring_mode::overwrite or m_capacity == 0) {
+    throw std::length_error("ring_vector is full");
+  }
+}
+
+/**
+ * @brief Moves the `n` elements in slots `[from, from + n)` to slot `to`.
+ *
+ * The destination slots outside the source must be raw; on return the source
+ * slots outside the destination are raw. Neither range wraps around.
+ */
+void move_block(size_type from, size_type n, size_type to){
+  if (from == to or n == 0){ return; }
+  if constexpr (relocatable) {
+    std::memmove(static_cast<void *>(m_buffer + to), static_cast<const void *>(m_buffer + from),
+                 n * sizeof(value_type));
+  } else if (to < from) {
+    for (size_type i{0}; i < n; ++i){
+      if (to + i < from){ alloc_traits::construct(m_alloc, m_buffer + to + i, std::move(m_buffer[from + i])); }
+      else { m_buffer[to + i] = std::move(m_buffer[from + i]); }
+    }
+    for (size_type i = std::max(from, to + n); i < from + n; ++i){ alloc_traits::destroy(m_alloc, m_buffer + i); }
+  } else {
+    for (size_type i = n; i-- > 0;){
+      if (to + i >= from + n){ alloc_traits::construct(m_alloc, m_buffer + to + i, std::move(m_buffer[from + i])); }
+      else { m_buffer[to + i] = std::move(m_buffer[from + i]); }
+    }
+    for (size_type i = from; i < std::min(from + n, to); ++i){ alloc_traits::destroy(m_alloc, m_buffer + i); }
+  }
+}
+
+/// Replaces everything with the elements of [first, last), `capacity` and `mode`.
+template <typename InputItr>
+void refill(InputItr first, InputItr last, size_type capacity, ring_mode mode){
+  if (capacity != m_capacity) {
+    release();
+    if (capacity != 0){ m_buffer = alloc_traits::allocate(m_alloc, capacity); }
+    m_capacity = capacity;
+  } else {
+    clear();
+  }
+  m_mode = mode;
+  for (; first != last; ++first){ emplace_back(*first); }
+}
+
+/// Destroys the elements and gives the storage back.
+void release(){
+  clear();
+  if (m_buffer != nullptr){ alloc_traits::deallocate(m_alloc, m_buffer, m_capacity); }
+  m_buffer = nullptr;
+  m_capacity = 0;
+}
+
+  size_type m_head;     //!< Slot of the front element.
+  size_type m_size;     //!< Number of elements.
+  size_type m_capacity; //!< Number of slots in the storage area.
+  T *m_buffer;          //!< The storage area (raw memory).
+  ring_mode m_mode;     //!< What a push into a full ring does.
+  Allocator m_alloc;    //!< Where the storage area comes from.
+};
+
+template <typename T, typename A>
+bool operator==(const ring_vector<T, A> &lhs, const ring_vector<T, A> &rhs) {
+  if (lhs.size() != rhs.size()) { return false; }
+  for (typename ring_vector<T, A>::size_type i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) { return false; }
+  }
+  return true;
+}
+
+template <typename T, typename A>
+bool operator!=(const ring_vector<T, A> &lhs, const ring_vector<T, A> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace sc.
+
+#endif
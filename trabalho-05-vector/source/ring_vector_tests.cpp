@@ -0,0 +1,169 @@
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <string>
+
+#include "ring_vector.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Tests for sc::ring_vector
+// =============================================================
+
+// Pushes and pops at both ends wrap around the storage area.
+#define RING_WRAP YES
+// A full bounded ring refuses new elements.
+#define RING_BOUNDED YES
+// A full overwrite ring drops the element at the opposite end.
+#define RING_OVERWRITE YES
+// The two segments cover the elements in order; linearize() joins them.
+#define RING_SEGMENTS YES
+// Element lifetime, copy and move.
+#define RING_LIFETIME YES
+
+namespace {
+/// Element type that keeps track of how many objects are alive.
+struct Alive {
+  static int count; //!< Objects currently alive.
+  std::string value;
+
+  Alive(std::string v) : value{std::move(v)} { ++count; }
+  Alive(const Alive &other) : value{other.value} { ++count; }
+  Alive(Alive &&other) noexcept : value{std::move(other.value)} { ++count; }
+  Alive &operator=(const Alive &) = default;
+  Alive &operator=(Alive &&) noexcept = default;
+  ~Alive() { --count; }
+
+  bool operator==(const Alive &rhs) const { return value == rhs.value; }
+  bool operator!=(const Alive &rhs) const { return value != rhs.value; }
+};
+int Alive::count = 0;
+
+/// Sums both segments, as a bulk kernel would.
+long sum_segments(const sc::ring_vector<int> &ring) {
+  long total{0};
+  for (int x : ring.first_segment())
+    total += x;
+  for (int x : ring.second_segment())
+    total += x;
+  return total;
+}
+} // namespace
+
+void run_ring_vector_tests(void) {
+  TestManager tm{"ring_vector testing"};
+
+#if RING_WRAP
+  {
+    BEGIN_TEST(tm, "RingWrap", "push_back()/pop_front() around the end");
+    sc::ring_vector<int> ring(5);
+    for (int i{0}; i < 5; ++i)
+      ring.push_back(i);
+    EXPECT_TRUE(ring.full());
+    ring.pop_front();
+    ring.pop_front();
+    ring.push_back(5);
+    ring.push_back(6);
+    EXPECT_EQ(ring.size(), 5u);
+    for (int i{0}; i < 5; ++i)
+      EXPECT_EQ(ring[i], i + 2);
+    ring.pop_back();
+    ring.push_front(1);
+    EXPECT_EQ(ring.front(), 1);
+    EXPECT_EQ(ring.back(), 5);
+    EXPECT_EQ(ring.at(4), 5);
+    EXPECT_EQ(std::accumulate(ring.begin(), ring.end(), 0), 1 + 2 + 3 + 4 + 5);
+    EXPECT_EQ(ring.end() - ring.begin(), 5);
+  }
+#endif
+
+#if RING_BOUNDED
+  {
+    BEGIN_TEST(tm, "RingBounded", "push into a full bounded ring");
+    sc::ring_vector<int> ring(2, sc::ring_mode::bounded);
+    ring.push_back(1);
+    ring.push_front(0);
+    bool thrown{false};
+    try { ring.push_back(2); } catch (const std::length_error &) { thrown = true; }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(ring.front(), 0);
+    EXPECT_EQ(ring.back(), 1);
+  }
+#endif
+
+#if RING_OVERWRITE
+  {
+    BEGIN_TEST(tm, "RingOverwrite", "rolling window of the last 4 samples");
+    sc::ring_vector<int> window(4, sc::ring_mode::overwrite);
+    for (int sample{1}; sample <= 10; ++sample)
+      window.push_back(sample);
+    EXPECT_EQ(window.size(), 4u);
+    EXPECT_EQ(window.front(), 7);
+    EXPECT_EQ(window.back(), 10);
+    EXPECT_EQ(sum_segments(window), 7 + 8 + 9 + 10);
+
+    window.push_front(0); // drops the newest sample.
+    EXPECT_EQ(window.front(), 0);
+    EXPECT_EQ(window.back(), 9);
+  }
+#endif
+
+#if RING_SEGMENTS
+  {
+    BEGIN_TEST(tm, "RingSegments", "first_segment(), second_segment(), linearize()");
+    sc::ring_vector<int> ring(8);
+    for (int i{0}; i < 6; ++i)
+      ring.push_back(i);
+    for (int i{0}; i < 4; ++i)
+      ring.pop_front();
+    for (int i{6}; i < 10; ++i)
+      ring.push_back(i); // wraps: 4 5 6 7 | 8 9
+    EXPECT_EQ(ring.first_segment().size, 4u);
+    EXPECT_EQ(ring.second_segment().size, 2u);
+    EXPECT_EQ(ring.first_segment().data[0], 4);
+    EXPECT_EQ(ring.second_segment().data[1], 9);
+
+    const int *flat = ring.linearize();
+    EXPECT_EQ(ring.second_segment().size, 0u);
+    for (int i{0}; i < 6; ++i)
+      EXPECT_EQ(flat[i], i + 4);
+  }
+#endif
+
+#if RING_LIFETIME
+  {
+    BEGIN_TEST(tm, "RingLifetime", "destruction, linearize(), copy and move");
+    Alive::count = 0;
+    {
+      sc::ring_vector<Alive> ring(4, sc::ring_mode::overwrite);
+      for (int i{0}; i < 7; ++i)
+        ring.emplace_back(std::to_string(i));
+      EXPECT_EQ(Alive::count, 4);
+      ring.pop_back(); // 3 4 5, wrapped
+      ring.linearize();
+      EXPECT_EQ(Alive::count, 3);
+      EXPECT_EQ(ring.front().value, "3");
+      EXPECT_EQ(ring.back().value, "5");
+
+      auto copy{ring};
+      EXPECT_EQ(copy, ring);
+      EXPECT_EQ(Alive::count, 6);
+      auto moved{std::move(ring)};
+      EXPECT_EQ(moved, copy);
+      EXPECT_EQ(ring.capacity(), 0u);
+      ring = copy;
+      EXPECT_EQ(ring.capacity(), 4u);
+      EXPECT_EQ(ring.mode(), sc::ring_mode::overwrite);
+      swap(ring, moved);
+      EXPECT_EQ(Alive::count, 9);
+    }
+    EXPECT_EQ(Alive::count, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,176 @@
+#include "simd.h"
+
+#include <algorithm> // std::min
+#include <cstring>   // std::memcpy
+#include <limits>    // std::numeric_limits
+
+/*!
+ * The kernels are written once, over GCC vector extensions of one 64-byte
+ * block. Each multiversioned entry point inlines them and so compiles the
+ * block operations for its own instruction set: one AVX-512 register, two
+ * AVX2 or four SSE2 ones. The last `n % lanes` elements go through a scalar
+ * loop.
+ */
+// The helpers below pass 64-byte vectors around, which would have a different
+// ABI per instruction set; they are always inlined (even at -O0), so none is
+// ever used. GCC reports -Wpsabi once, at the end of the translation unit,
+// where a `diagnostic push`/`pop` pair around the helpers has no effect: the
+// pragma has to hold for the whole file, which has no other entry points
+// than the kernels below.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace sc::simd {
+
+namespace {
+
+/// Bytes processed per step.
+constexpr std::size_t block_bytes = 64;
+
+/// GCC vector of `N` elements of type T (an alias template drops the attribute).
+template <typename T, std::size_t N> struct vec_of {
+  typedef T type __attribute__((vector_size(N * sizeof(T))));
+};
+template <typename T, std::size_t N> using vec_t = typename vec_of<T, N>::type;
+
+/// Elements of type T in one block.
+template <typename T> inline constexpr std::size_t lanes = block_bytes / sizeof(T);
+
+template <typename T> using block = vec_t<T, lanes<T>>;
+
+/// Result of comparing two blocks: all bits set in the lanes that match.
+template <typename T> using mask = decltype(block<T>{} == block<T>{});
+
+template <typename T> [[gnu::always_inline]] inline block<T> load(const T *p) {
+  block<T> v;
+  std::memcpy(&v, p, sizeof v);
+  return v;
+}
+
+template <typename T> [[gnu::always_inline]] inline block<T> broadcast(T value) {
+  return block<T>{} + value;
+}
+
+/// Whether any lane of `m` is set.
+template <typename M> [[gnu::always_inline]] inline bool any(const M &m) {
+  std::uint64_t words[sizeof(M) / sizeof(std::uint64_t)];
+  std::memcpy(words, &m, sizeof m);
+  std::uint64_t set{0};
+  for (auto word : words)
+    set |= word;
+  return set != 0;
+}
+
+template <typename T>
+[[gnu::always_inline]] inline std::size_t find_first_impl(const T *data, std::size_t n, T value) {
+  const block<T> needle = broadcast(value);
+  std::size_t i{0};
+  // Skip whole blocks without a match; the scalar loop finds it in the next one.
+  for (; i + lanes<T> <= n; i += lanes<T>) {
+    if (any(load(data + i) == needle)) { break; }
+  }
+  for (; i < n; ++i) {
+    if (data[i] == value) { return i; }
+  }
+  return n;
+}
+
+template <typename T>
+[[gnu::always_inline]] inline std::size_t count_impl(const T *data, std::size_t n, T value) {
+  using counter = typename std::remove_reference_t<decltype(mask<T>{}[0])>;
+  // Lane counters are flushed before they may overflow.
+  constexpr std::size_t max_blocks = std::numeric_limits<counter>::max();
+  const block<T> needle = broadcast(value);
+  std::size_t total{0};
+  std::size_t i{0};
+  while (i + lanes<T> <= n) {
+    const std::size_t stop = i + std::min((n - i) / lanes<T>, max_blocks) * lanes<T>;
+    mask<T> hits{};
+    for (; i < stop; i += lanes<T>)
+      hits -= (load(data + i) == needle); // A match is -1.
+    for (std::size_t j{0}; j < lanes<T>; ++j)
+      total += hits[j];
+  }
+  for (; i < n; ++i)
+    total += data[i] == value;
+  return total;
+}
+
+/// Smallest (or, with `Largest`, largest) element; requires `n > 0`.
+template <bool Largest, typename T>
+[[gnu::always_inline]] inline T extreme_impl(const T *data, std::size_t n) {
+  // No lambdas here: one taking blocks would not be compiled per clone.
+  if (n < lanes<T>) { return Largest ? scalar::max(data, n) : scalar::min(data, n); }
+  block<T> best = load(data);
+  std::size_t i{lanes<T>};
+  for (; i + lanes<T> <= n; i += lanes<T>) {
+    const block<T> v = load(data + i);
+    best = (Largest ? best < v : v < best) ? v : best;
+  }
+  T result = best[0];
+  for (std::size_t j{1}; j < lanes<T>; ++j)
+    result = (Largest ? result < best[j] : best[j] < result) ? best[j] : result;
+  for (; i < n; ++i)
+    result = (Largest ? result < data[i] : data[i] < result) ? data[i] : result;
+  return result;
+}
+
+template <typename T>
+[[gnu::always_inline]] inline sum_t<T> sum_impl(const T *data, std::size_t n) {
+  using acc_t = vec_t<sum_t<T>, lanes<T>>;
+  acc_t acc{};
+  std::size_t i{0};
+  for (; i + lanes<T> <= n; i += lanes<T>)
+    acc += __builtin_convertvector(load(data + i), acc_t);
+  sum_t<T> total{};
+  for (std::size_t j{0}; j < lanes<T>; ++j)
+    total += acc[j];
+  for (; i < n; ++i)
+    total += data[i];
+  return total;
+}
+
+template <typename T>
+[[gnu::always_inline]] inline sum_t<T> dot_impl(const T *a, const T *b, std::size_t n) {
+  using acc_t = vec_t<sum_t<T>, lanes<T>>;
+  acc_t acc{};
+  std::size_t i{0};
+  for (; i + lanes<T> <= n; i += lanes<T>)
+    acc += __builtin_convertvector(load(a + i), acc_t) * __builtin_convertvector(load(b + i), acc_t);
+  sum_t<T> total{};
+  for (std::size_t j{0}; j < lanes<T>; ++j)
+    total += acc[j];
+  for (; i < n; ++i)
+    total += sum_t<T>(a[i]) * sum_t<T>(b[i]);
+  return total;
+}
+
+} // namespace
+
+/// Defines the multiversioned kernels for one element type.
+#define SC_SIMD_DEFINE_KERNELS(T)                                                                  \
+  SC_SIMD_CLONES std::size_t find_first(const T *data, std::size_t n, T value) {                   \
+    return find_first_impl(data, n, value);                                                        \
+  }                                                                                                \
+  SC_SIMD_CLONES std::size_t count(const T *data, std::size_t n, T value) {                        \
+    return count_impl(data, n, value);                                                             \
+  }                                                                                                \
+  SC_SIMD_CLONES T min(const T *data, std::size_t n) { return extreme_impl<false>(data, n); }      \
+  SC_SIMD_CLONES T max(const T *data, std::size_t n) { return extreme_impl<true>(data, n); }       \
+  SC_SIMD_CLONES std::size_t argmin(const T *data, std::size_t n) {                                \
+    return find_first_impl(data, n, extreme_impl<false>(data, n));                                 \
+  }                                                                                                \
+  SC_SIMD_CLONES std::size_t argmax(const T *data, std::size_t n) {                                \
+    return find_first_impl(data, n, extreme_impl<true>(data, n));                                  \
+  }                                                                                                \
+  SC_SIMD_CLONES sum_t<T> sum(const T *data, std::size_t n) { return sum_impl(data, n); }          \
+  SC_SIMD_CLONES sum_t<T> dot(const T *a, const T *b, std::size_t n) { return dot_impl(a, b, n); }
+
+SC_SIMD_DEFINE_KERNELS(std::int32_t)
+SC_SIMD_DEFINE_KERNELS(float)
+SC_SIMD_DEFINE_KERNELS(double)
+
+#undef SC_SIMD_DEFINE_KERNELS
+
+} // namespace sc::simd.
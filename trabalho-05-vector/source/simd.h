@@ -0,0 +1,216 @@
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+#include <algorithm> // std::find, std::count, std::min_element, std::max_element
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::int32_t, std::int64_t
+#include <functional> // std::plus
+#include <numeric>   // std::accumulate, std::inner_product
+#include <stdexcept> // std::length_error
+#include <type_traits>
+
+#include "vector.h"
+
+/*!
+ * Marks a function to be compiled once per instruction set and picked by
+ * the dynamic loader for the CPU it runs on (function multiversioning).
+ * Only x86-64 ELF targets have the ifunc support this relies on; elsewhere
+ * the kernels are compiled once, for the target of the build.
+ */
+#if defined(__x86_64__) && defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+#define SC_SIMD_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#define SC_HAS_SIMD_CLONES 1
+#else
+#define SC_SIMD_CLONES
+#define SC_HAS_SIMD_CLONES 0
+#endif
+
+/// Sequence container namespace.
+namespace sc {
+
+/*!
+ * Search and reduction kernels over contiguous arithmetic data.
+ *
+ * The kernels take a pointer and a length, so they work on any sc::vector
+ * through `data()`; the overloads at the end of this header do exactly that.
+ * They are defined in simd.cpp for `std::int32_t`, `float` and `double`, with
+ * an AVX-512, an AVX2 and a baseline (SSE2) version of each, selected at load
+ * time for the running CPU. Other element types fall back to scalar::.
+ *
+ * Floating point sums and dot products add several lanes side by side, so
+ * their rounding may differ from a left-to-right loop; float data is
+ * accumulated in double, which keeps long sums accurate. min/max/argmin/argmax
+ * do not support NaNs (the result is unspecified) and need `n > 0`.
+ */
+namespace simd {
+
+/// Type that sum() and dot() accumulate into: 64 bits for integers, at least
+/// double for floating point.
+template <typename T>
+using sum_t = std::conditional_t<std::is_integral_v<T>, std::int64_t, std::common_type_t<T, double>>;
+
+/// Element types with multiversioned kernels.
+template <typename T>
+inline constexpr bool has_kernels_v = std::is_same_v<T, std::int32_t> ||
+                                      std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/*!
+ * Reference kernels: plain loops through the standard algorithms, for any
+ * element type. They are also the baseline of bench/simd_bench.cpp.
+ */
+namespace scalar {
+template <typename T> std::size_t find_first(const T *data, std::size_t n, const T &value) {
+  return std::find(data, data + n, value) - data;
+}
+template <typename T> std::size_t count(const T *data, std::size_t n, const T &value) {
+  return std::count(data, data + n, value);
+}
+template <typename T> T min(const T *data, std::size_t n) { return *std::min_element(data, data + n); }
+template <typename T> T max(const T *data, std::size_t n) { return *std::max_element(data, data + n); }
+template <typename T> std::size_t argmin(const T *data, std::size_t n) {
+  return std::min_element(data, data + n) - data;
+}
+template <typename T> std::size_t argmax(const T *data, std::size_t n) {
+  return std::max_element(data, data + n) - data;
+}
+template <typename T> sum_t<T> sum(const T *data, std::size_t n) {
+  return std::accumulate(data, data + n, sum_t<T>{});
+}
+template <typename T> sum_t<T> dot(const T *a, const T *b, std::size_t n) {
+  return std::inner_product(a, a + n, b, sum_t<T>{}, std::plus<>{},
+                            [](T x, T y) { return sum_t<T>(x) * sum_t<T>(y); });
+}
+} // namespace scalar.
+
+/// Declares the multiversioned kernels for one element type.
+#define SC_SIMD_DECLARE_KERNELS(T)                                                   \
+  /** Index of the first element equal to `value`, or `n`. */                       \
+  std::size_t find_first(const T *data, std::size_t n, T value);                     \
+  /** Number of elements equal to `value`. */                                       \
+  std::size_t count(const T *data, std::size_t n, T value);                          \
+  /** Smallest element. */                                                          \
+  T min(const T *data, std::size_t n);                                               \
+  /** Largest element. */                                                           \
+  T max(const T *data, std::size_t n);                                               \
+  /** Index of the first smallest element. */                                       \
+  std::size_t argmin(const T *data, std::size_t n);                                  \
+  /** Index of the first largest element. */                                        \
+  std::size_t argmax(const T *data, std::size_t n);                                  \
+  /** Sum of the elements. */                                                       \
+  sum_t<T> sum(const T *data, std::size_t n);                                        \
+  /** Sum of `a[i] * b[i]`. */                                                      \
+  sum_t<T> dot(const T *a, const T *b, std::size_t n);
+
+SC_SIMD_DECLARE_KERNELS(std::int32_t)
+SC_SIMD_DECLARE_KERNELS(float)
+SC_SIMD_DECLARE_KERNELS(double)
+
+#undef SC_SIMD_DECLARE_KERNELS
+
+// [I] sc::vector overloads.
+
+/// Index of the first element of `vec` equal to `value`, or `vec.size()`.
+template <typename T, typename A, typename G, typename R>
+std::size_t find_first(const vector<T, A, G, R> &vec, const T &value) {
+  if constexpr (has_kernels_v<T>) {
+    return find_first(vec.data(), vec.size(), value);
+  } else {
+    return scalar::find_first(vec.data(), vec.size(), value);
+  }
+}
+
+/// Whether `vec` has an element equal to `value`.
+template <typename T, typename A, typename G, typename R>
+bool contains(const vector<T, A, G, R> &vec, const T &value) {
+  return find_first(vec, value) != vec.size();
+}
+
+/// Number of elements of `vec` equal to `value`.
+template <typename T, typename A, typename G, typename R>
+std::size_t count(const vector<T, A, G, R> &vec, const T &value) {
+  if constexpr (has_kernels_v<T>) {
+    return count(vec.data(), vec.size(), value);
+  } else {
+    return scalar::count(vec.data(), vec.size(), value);
+  }
+}
+
+/**
+ * @brief Smallest element of `vec`.
+ * @throws std::length_error if the vector is empty.
+ */
+template <typename T, typename A, typename G, typename R>
+T min(const vector<T, A, G, R> &vec) {
+  if (vec.empty()) { throw std::length_error("there is no element in array"); }
+  if constexpr (has_kernels_v<T>) {
+    return min(vec.data(), vec.size());
+  } else {
+    return scalar::min(vec.data(), vec.size());
+  }
+}
+
+/**
+ * @brief Largest element of `vec`.
+ * @throws std::length_error if the vector is empty.
+ */
+template <typename T, typename A, typename G, typename R>
+T max(const vector<T, A, G, R> &vec) {
+  if (vec.empty()) { throw std::length_error("there is no element in array"); }
+  if constexpr (has_kernels_v<T>) {
+    return max(vec.data(), vec.size());
+  } else {
+    return scalar::max(vec.data(), vec.size());
+  }
+}
+
+/// Index of the first smallest element of `vec`, or 0 if it is empty.
+template <typename T, typename A, typename G, typename R>
+std::size_t argmin(const vector<T, A, G, R> &vec) {
+  if (vec.empty()) { return 0; }
+  if constexpr (has_kernels_v<T>) {
+    return argmin(vec.data(), vec.size());
+  } else {
+    return scalar::argmin(vec.data(), vec.size());
+  }
+}
+
+/// Index of the first largest element of `vec`, or 0 if it is empty.
+template <typename T, typename A, typename G, typename R>
+std::size_t argmax(const vector<T, A, G, R> &vec) {
+  if (vec.empty()) { return 0; }
+  if constexpr (has_kernels_v<T>) {
+    return argmax(vec.data(), vec.size());
+  } else {
+    return scalar::argmax(vec.data(), vec.size());
+  }
+}
+
+/// Sum of the elements of `vec`.
+template <typename T, typename A, typename G, typename R>
+sum_t<T> sum(const vector<T, A, G, R> &vec) {
+  if constexpr (has_kernels_v<T>) {
+    return sum(vec.data(), vec.size());
+  } else {
+    return scalar::sum(vec.data(), vec.size());
+  }
+}
+
+/**
+ * @brief Dot product of `a` and `b`.
+ * @throws std::length_error if the vectors have different sizes.
+ */
+template <typename T, typename A, typename G, typename R>
+sum_t<T> dot(const vector<T, A, G, R> &a, const vector<T, A, G, R> &b) {
+  if (a.size() != b.size()) { throw std::length_error("dot() of vectors with different sizes"); }
+  if constexpr (has_kernels_v<T>) {
+    return dot(a.data(), b.data(), a.size());
+  } else {
+    return scalar::dot(a.data(), b.data(), a.size());
+  }
+}
+
+} // namespace simd.
+
+} // namespace sc.
+
+#endif
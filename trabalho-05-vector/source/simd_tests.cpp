@@ -0,0 +1,187 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "simd.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Tests for the sc::simd kernels
+// =============================================================
+
+// find_first()/contains() agree with the scalar search, wherever the match is.
+#define SIMD_FIND YES
+// count() agrees with the scalar count.
+#define SIMD_COUNT YES
+// min/max/argmin/argmax, with ties resolved to the first index.
+#define SIMD_MIN_MAX YES
+// sum() and dot() agree with the scalar loops.
+#define SIMD_SUM_DOT YES
+// Other element types and empty vectors.
+#define SIMD_FALLBACK YES
+
+namespace {
+/// Values in [-range, range) that repeat irregularly.
+template <typename T> sc::vector<T> pattern(std::size_t n, int range) {
+  sc::vector<T> vec;
+  for (std::size_t i{0}; i < n; ++i)
+    vec.push_back(T((i * 7919 + 13) % (2 * range)) - T(range));
+  return vec;
+}
+} // namespace
+
+void run_simd_tests(void) {
+  TestManager tm{"SIMD kernel testing"};
+
+#if SIMD_FIND
+  {
+    BEGIN_TEST(tm, "SimdFind", "find_first() and contains() on int32, float, double");
+    // Sizes and positions around the block edges and the scalar tail.
+    for (std::size_t n : {0u, 1u, 15u, 16u, 17u, 63u, 64u, 100u, 1000u}) {
+      for (std::size_t at : {0u, 7u, 15u, 16u, 31u, 40u, 99u, 998u, 999u}) {
+        if (at >= n) { continue; }
+        sc::vector<std::int32_t> ints(n);
+        sc::vector<float> floats(n);
+        sc::vector<double> doubles(n);
+        ints[at] = 5;
+        floats[at] = 5.0f;
+        doubles[at] = 5.0;
+        EXPECT_EQ(sc::simd::find_first(ints, 5), at);
+        EXPECT_EQ(sc::simd::find_first(floats, 5.0f), at);
+        EXPECT_EQ(sc::simd::find_first(doubles, 5.0), at);
+      }
+      sc::vector<std::int32_t> none(n);
+      EXPECT_EQ(sc::simd::find_first(none, 1), n);
+      EXPECT_FALSE(sc::simd::contains(none, 1));
+    }
+    const auto vec = pattern<std::int32_t>(1000, 300);
+    for (std::int32_t value : {-300, -1, 0, 17, 299, 300})
+      EXPECT_EQ(sc::simd::find_first(vec, value), sc::simd::scalar::find_first(vec.data(), vec.size(), value));
+  }
+#endif
+
+#if SIMD_COUNT
+  {
+    BEGIN_TEST(tm, "SimdCount", "count() on int32, float, double");
+    for (std::size_t n : {0u, 5u, 16u, 33u, 1000u, 4099u}) {
+      const auto ints = pattern<std::int32_t>(n, 10);
+      const auto floats = pattern<float>(n, 10);
+      const auto doubles = pattern<double>(n, 10);
+      for (int value : {-10, -3, 0, 9, 10}) {
+        EXPECT_EQ(sc::simd::count(ints, value), sc::simd::scalar::count(ints.data(), n, value));
+        EXPECT_EQ(sc::simd::count(floats, float(value)), sc::simd::scalar::count(floats.data(), n, float(value)));
+        EXPECT_EQ(sc::simd::count(doubles, double(value)), sc::simd::scalar::count(doubles.data(), n, double(value)));
+      }
+    }
+  }
+#endif
+
+#if SIMD_MIN_MAX
+  {
+    BEGIN_TEST(tm, "SimdMinMax", "min(), max(), argmin(), argmax()");
+    for (std::size_t n : {1u, 7u, 16u, 17u, 100u, 1001u}) {
+      const auto ints = pattern<std::int32_t>(n, 50);
+      const auto doubles = pattern<double>(n, 50);
+      EXPECT_EQ(sc::simd::min(ints), sc::simd::scalar::min(ints.data(), n));
+      EXPECT_EQ(sc::simd::max(ints), sc::simd::scalar::max(ints.data(), n));
+      EXPECT_EQ(sc::simd::argmin(ints), sc::simd::scalar::argmin(ints.data(), n));
+      EXPECT_EQ(sc::simd::argmax(ints), sc::simd::scalar::argmax(ints.data(), n));
+      EXPECT_EQ(sc::simd::min(doubles), sc::simd::scalar::min(doubles.data(), n));
+      EXPECT_EQ(sc::simd::argmax(doubles), sc::simd::scalar::argmax(doubles.data(), n));
+    }
+    // The extreme sits in the scalar tail, and then in every lane of a block.
+    sc::vector<float> floats(37);
+    floats[36] = -2.0f;
+    EXPECT_EQ(sc::simd::argmin(floats), 36u);
+    for (std::size_t at{0}; at < 16; ++at) {
+      sc::vector<float> one(64);
+      one[16 + at] = 3.5f;
+      one[48 + at] = 3.5f;
+      EXPECT_EQ(sc::simd::max(one), 3.5f);
+      EXPECT_EQ(sc::simd::argmax(one), 16 + at);
+    }
+  }
+#endif
+
+#if SIMD_SUM_DOT
+  {
+    BEGIN_TEST(tm, "SimdSumDot", "sum() and dot()");
+    for (std::size_t n : {0u, 3u, 16u, 31u, 1000u, 10007u}) {
+      const auto ints = pattern<std::int32_t>(n, 1000);
+      EXPECT_EQ(sc::simd::sum(ints), sc::simd::scalar::sum(ints.data(), n));
+      EXPECT_EQ(sc::simd::dot(ints, ints), sc::simd::scalar::dot(ints.data(), ints.data(), n));
+
+      // Small integers add up exactly in any order.
+      const auto doubles = pattern<double>(n, 1000);
+      const auto floats = pattern<float>(n, 8);
+      EXPECT_EQ(sc::simd::sum(doubles), sc::simd::scalar::sum(doubles.data(), n));
+      EXPECT_EQ(sc::simd::dot(floats, floats), sc::simd::scalar::dot(floats.data(), floats.data(), n));
+    }
+    // No overflow in 32 bits: the sum is accumulated in 64.
+    sc::vector<std::int32_t> big(100);
+    for (auto &x : big)
+      x = 2'000'000'000;
+    EXPECT_EQ(sc::simd::sum(big), std::int64_t{200'000'000'000});
+
+    // Nor for floats, which are accumulated in double: in float, 2^24 + 1 == 2^24.
+    sc::vector<float> ones(65);
+    for (auto &x : ones)
+      x = 1.0f;
+    const sc::vector<float> weights{ones};
+    ones[0] = 16'777'216.0f;
+    EXPECT_EQ(sc::simd::sum(ones), 16'777'280.0);
+    EXPECT_EQ(sc::simd::dot(ones, weights), 16'777'280.0);
+
+    sc::vector<double> halves(1000);
+    for (auto &x : halves)
+      x = 0.1;
+    EXPECT_TRUE(std::abs(sc::simd::sum(halves) - 100.0) < 1e-9);
+  }
+#endif
+
+#if SIMD_FALLBACK
+  {
+    BEGIN_TEST(tm, "SimdFallback", "sc::vector<std::string>, <long>, <std::uint32_t>, empty vectors");
+    sc::vector<std::string> words{"b", "a", "c", "a"};
+    EXPECT_EQ(sc::simd::find_first(words, std::string{"a"}), 1u);
+    EXPECT_EQ(sc::simd::count(words, std::string{"a"}), 2u);
+    EXPECT_EQ(sc::simd::min(words), "a");
+    EXPECT_EQ(sc::simd::argmax(words), 2u);
+
+    sc::vector<long> longs{3, -4, 5};
+    EXPECT_EQ(sc::simd::sum(longs), 4);
+    EXPECT_EQ(sc::simd::dot(longs, longs), 50);
+    // The products are widened before they are multiplied.
+    sc::vector<std::uint32_t> wide{4'000'000'000u, 3u};
+    EXPECT_EQ(sc::simd::dot(wide, sc::vector<std::uint32_t>{4u, 5u}), std::int64_t{16'000'000'015});
+
+    sc::vector<std::int32_t> empty;
+    EXPECT_EQ(sc::simd::sum(empty), 0);
+    EXPECT_EQ(sc::simd::argmin(empty), 0u);
+    bool thrown{false};
+    try {
+      sc::simd::min(empty);
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    thrown = false;
+    try {
+      sc::simd::dot(empty, sc::vector<std::int32_t>{1});
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,698 @@
+#ifndef _SMALL_VECTOR_H_
+#define _SMALL_VECTOR_H_
+
+#include "vector.h" // sc::MyForwardIterator, sc::growth, sc::is_trivially_relocatable
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Vector that keeps its first elements inside the object itself.
+/*!
+ * sc::small_vector offers the same interface as sc::vector, but the first
+ * `N` elements live in a buffer embedded in the object, so a small_vector
+ * holding up to `N` elements never touches the heap. Once it needs more room
+ * the elements spill over to storage obtained from the allocator, and from
+ * then on it behaves like sc::vector. shrink_to_fit() moves them back into
+ * the inline buffer when they fit again.
+ *
+ * Since the inline elements are part of the object, moving or swapping
+ * small_vectors moves the elements themselves (O(size())) unless they are on
+ * the heap, and iterators are invalidated by those operations.
+ *
+ * \tparam T The type of the elements.
+ * \tparam N How many elements fit in the inline buffer.
+ * \tparam Allocator The allocator used once the elements spill to the heap.
+ * \tparam GrowthPolicy How the capacity grows past `N` (see sc::growth).
+ */
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = growth::doubling>
+class small_vector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(N > 0, "use sc::vector for a vector without inline storage");
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Allocator::value_type must be the same as T");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T *>,
+                "sc::small_vector requires an allocator with raw pointers");
+
+  //=== Aliases
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using const_pointer = const value_type *; //!< Pointer to a const value.
+  using reference = value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value stored in the container.
+  using iterator = MyForwardIterator<value_type>; //!< The iterator.
+  using const_iterator = MyForwardIterator<const value_type>; //!< The const_iterator.
+  using allocator_type = Allocator;   //!< The allocator type.
+  using growth_policy = GrowthPolicy; //!< The capacity growth policy.
+
+  /// Number of elements that fit in the inline buffer.
+  static constexpr size_type inline_capacity = N;
+
+  //=== [I] SPECIAL MEMBERS
+/**
+ * @brief Constructs an empty small_vector on its inline buffer.
+ */
+small_vector() : small_vector(Allocator()) {}
+
+/**
+ * @brief Constructs an empty small_vector that spills over to `alloc`.
+ *
+ * @param alloc The allocator to use.
+ */
+explicit small_vector(const Allocator &alloc) noexcept
+  : m_end{0}, m_capacity{N}, m_storage{inline_data()}, m_alloc{alloc} {}
+
+/**
+ * @brief Constructs a small_vector with `count` value-initialized elements.
+ *
+ * @param count The initial size.
+ * @param alloc The allocator to use.
+ */
+explicit small_vector(size_type count, const Allocator &alloc = Allocator())
+  : small_vector(alloc) {
+  reserve(count);
+  construct_n(m_storage, count);
+  m_end = count;
+}
+
+/**
+ * @brief Constructs a small_vector with elements from an initializer list.
+ *
+ * @param il The initializer list.
+ * @param alloc The allocator to use.
+ */
+small_vector(const std::initializer_list<T> &il, const Allocator &alloc = Allocator())
+  : small_vector(il.begin(), il.end(), alloc) {}
+
+/**
+ * @brief Constructs a small_vector from the range [first, last).
+ *
+ * @param first Iterator to the beginning of the range.
+ * @param last Iterator to the end of the range.
+ * @param alloc The allocator to use.
+ */
+template <typename InputItr>
+small_vector(InputItr first, InputItr last, const Allocator &alloc = Allocator())
+  : small_vector(alloc) {
+  assign_n(first, std::distance(first, last));
+}
+
+/**
+ * @brief Copy constructor.
+ *
+ * @param other The small_vector to copy from.
+ */
+small_vector(const small_vector &other)
+  : small_vector(other, alloc_traits::select_on_container_copy_construction(other.m_alloc)) {}
+
+/**
+ * @brief Copy constructor with a given allocator.
+ *
+ * @param other The small_vector to copy from.
+ * @param alloc The allocator to use.
+ */
+small_vector(const small_vector &other, const Allocator &alloc)
+  : small_vector(alloc) {
+  assign_n(other.m_storage, other.m_end);
+}
+
+/**
+ * @brief Move constructor.
+ *
+ * Heap storage is taken over in O(1); inline elements are moved one by one.
+ * Either way `other` is left empty.
+ *
+ * @param other The small_vector to move from.
+ */
+small_vector(small_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+  : small_vector(other.m_alloc) {
+  take(other);
+}
+
+/**
+ * @brief Destructor.
+ */
+~small_vector() { reset_to_inline(); }
+
+/**
+ * @brief Copy assignment operator.
+ *
+ * @param rhs The small_vector to copy from.
+ * @return Reference to the modified small_vector.
+ */
+small_vector &operator=(const small_vector &rhs) {
+  if (this == &rhs) { return *this; }
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+    if (m_alloc != rhs.m_alloc) { reset_to_inline(); }
+    m_alloc = rhs.m_alloc;
+  }
+  assign_n(rhs.m_storage, rhs.m_end);
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ *
+ * Heap storage of `rhs` is taken over when our allocator can release it;
+ * otherwise the elements are moved one by one. `rhs` is left empty.
+ *
+ * @param rhs The small_vector to move from.
+ * @return Reference to the modified small_vector.
+ */
+small_vector &operator=(small_vector &&rhs) {
+  if (this == &rhs) { return *this; }
+  if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+    reset_to_inline();
+    m_alloc = rhs.m_alloc;
+    take(rhs);
+  } else {
+    if (not rhs.is_inline() and m_alloc == rhs.m_alloc) {
+      reset_to_inline();
+      take(rhs);
+    } else {
+      assign_n(std::make_move_iterator(rhs.m_storage), rhs.m_end);
+      rhs.clear();
+    }
+  }
+  return *this;
+}
+
+/// Returns a copy of the allocator used for the heap storage.
+allocator_type get_allocator() const { return m_alloc; }
+
+  //=== [II] ITERATORS
+iterator begin() { return iterator{m_storage}; }
+iterator end() { return iterator(m_storage + m_end); }
+const_iterator begin() const { return const_iterator(m_storage); }
+const_iterator end() const { return const_iterator(m_storage + m_end); }
+const_iterator cbegin() const { return const_iterator(m_storage); }
+const_iterator cend() const { return const_iterator(m_storage + m_end); }
+
+  // [III] Capacity
+[[nodiscard]] bool full() const { return m_end == m_capacity; }
+[[nodiscard]] size_type size() const { return m_end; }
+[[nodiscard]] size_type capacity() const { return m_capacity; }
+[[nodiscard]] bool empty() const { return m_end == 0; }
+/// Tells whether the elements are in the inline buffer (i.e., not on the heap).
+[[nodiscard]] bool is_inline() const { return m_storage == inline_data(); }
+
+  // [IV] Modifiers
+void clear(){
+  destroy(m_storage, m_storage + m_end);
+  m_end = 0;
+}
+
+/**
+ * @brief Inserts an element at the beginning of the small_vector.
+ *
+ * @param value The value to be inserted.
+ */
+void push_front(const_reference value){ emplace(begin(), value); }
+
+/**
+ * @brief Inserts an element at the beginning of the small_vector, moving it in.
+ *
+ * @param value The value to be inserted.
+ */
+void push_front(value_type &&value){ emplace(begin(), std::move(value)); }
+
+/**
+ * @brief Inserts an element at the end of the small_vector.
+ *
+ * @param value The value to be inserted.
+ */
+void push_back(const_reference value){ emplace_back(value); }
+
+/**
+ * @brief Inserts an element at the end of the small_vector, moving it in.
+ *
+ * @param value The value to be inserted.
+ */
+void push_back(value_type &&value){ emplace_back(std::move(value)); }
+
+/**
+ * @brief Constructs an element in place at the end of the small_vector.
+ *
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ */
+template <typename... Args>
+reference emplace_back(Args &&...args){
+  if (full()){
+    realloc_emplace(m_end, std::forward<Args>(args)...);
+  } else {
+    construct_at(m_storage + m_end, std::forward<Args>(args)...);
+    ++m_end;
+  }
+  return m_storage[m_end - 1];
+}
+
+/**
+ * @brief Constructs an element in place right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return An iterator pointing to the new element.
+ */
+template <typename... Args>
+iterator emplace(const_iterator pos, Args &&...args){
+  const size_type idx = pos - cbegin();
+  if (full()){
+    realloc_emplace(idx, std::forward<Args>(args)...);
+  } else if (idx == m_end){
+    construct_at(m_storage + m_end, std::forward<Args>(args)...);
+    ++m_end;
+  } else {
+    // The arguments may refer to an element that is about to be shifted.
+    value_type tmp(std::forward<Args>(args)...);
+    open_gap(idx, 1);
+    try {
+      construct_at(m_storage + idx, std::move(tmp));
+    } catch (...) {
+      close_gap(idx, 1);
+      throw;
+    }
+    ++m_end;
+  }
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes the last element.
+ *
+ * @throws std::length_error if the small_vector is empty.
+ */
+void pop_back(){
+  if(empty()){throw std::length_error("POP_BACK(EMPTY)\n");}
+  destroy_at(m_storage + --m_end);
+}
+
+/**
+ * @brief Removes the first element.
+ *
+ * @throws std::length_error if the small_vector is empty.
+ */
+void pop_front(){
+  if(empty()){throw std::length_error("POP_FRONT(EMPTY)\n");}
+  erase(begin());
+}
+
+/**
+ * @brief Inserts the range [first, last) right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the elements will be inserted.
+ * @param first Iterator to the beginning of the range of elements to insert.
+ * @param last Iterator to the end of the range of elements to insert.
+ * @return An iterator pointing to the first inserted element, or pos if the range is empty.
+ */
+template<typename InputItr>
+iterator insert(const_iterator pos, InputItr first, InputItr last){
+  const size_type idx = pos - cbegin();
+  const size_type count = std::distance(first, last);
+  if (count == 0) { return begin() + idx; }
+  grow_for(m_end + count);
+  open_gap(idx, count);
+  try {
+    construct_copies(first, count, m_storage + idx);
+  } catch (...) {
+    close_gap(idx, count);
+    throw;
+  }
+  m_end += count;
+  return begin() + idx;
+}
+
+/**
+ * @brief Inserts the elements of `ilist` right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the elements will be inserted.
+ * @param ilist Initializer list containing elements to insert.
+ * @return An iterator pointing to the first inserted element, or pos if the list is empty.
+ */
+iterator insert(const_iterator pos, const std::initializer_list<value_type> &ilist){
+  return insert(pos, ilist.begin(), ilist.end());
+}
+
+/**
+ * @brief Inserts a copy of `value` right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param value The value to be inserted.
+ * @return An iterator pointing to the inserted element.
+ */
+iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+
+/**
+ * @brief Moves `value` in right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param value The value to be inserted.
+ * @return An iterator pointing to the inserted element.
+ */
+iterator insert(const_iterator pos, value_type &&value) { return emplace(pos, std::move(value)); }
+
+/**
+ * @brief Increases the capacity to at least `new_cap`.
+ *
+ * A capacity within the inline buffer is always available, so this only
+ * allocates when `new_cap > N`.
+ *
+ * @param new_cap The new capacity.
+ */
+void reserve(size_type new_cap){
+  if(new_cap <= m_capacity){return;}
+  reallocate(new_cap);
+}
+
+/**
+ * @brief Reduces the capacity to fit the size.
+ *
+ * Elements on the heap are moved back into the inline buffer if they fit.
+ */
+void shrink_to_fit(){
+  if (is_inline() or m_end == m_capacity){ return; }
+  if (m_end <= N){
+    relocate(m_storage, m_storage + m_end, inline_data());
+    deallocate_heap();
+    m_storage = inline_data();
+    m_capacity = N;
+  } else {
+    reallocate(m_end);
+  }
+}
+
+/**
+ * @brief Replaces the contents with the elements from [first, last).
+ *
+ * @param first Iterator to the beginning of the range of elements to assign.
+ * @param last Iterator to the end of the range of elements to assign.
+ */
+template <typename InputItr>
+void assign(InputItr first, InputItr last) {
+  assign_n(first, std::distance(first, last));
+}
+
+/**
+ * @brief Replaces the contents with `count` copies of `value`.
+ *
+ * @param count The number of elements to assign.
+ * @param value The value to assign to the elements.
+ */
+void assign(size_type count, const_reference value) {
+  if (count > m_capacity) {
+    // `value` may live inside the buffer we are about to release.
+    value_type copy(value);
+    clear();
+    grow_for(count);
+    construct_n(m_storage, count, copy);
+  } else if (count <= m_end) {
+    std::fill_n(m_storage, count, value);
+    destroy(m_storage + count, m_storage + m_end);
+  } else {
+    std::fill_n(m_storage, m_end, value);
+    construct_n(m_storage + m_end, count - m_end, value);
+  }
+  m_end = count;
+}
+
+/**
+ * @brief Replaces the contents with the elements of `ilist`.
+ *
+ * @param ilist Initializer list containing elements to assign.
+ */
+void assign(const std::initializer_list<T> &ilist) {
+  assign(ilist.begin(), ilist.end());
+}
+
+/**
+ * @brief Removes the elements in [first, last).
+ *
+ * @param first Iterator pointing to the beginning of the range to erase.
+ * @param last Iterator pointing to the end of the range to erase.
+ * @return An iterator pointing to the position of the first erased element.
+ * @throws std::out_of_range if the container is empty or if the provided iterators are invalid.
+ */
+iterator erase(const_iterator first, const_iterator last) {
+  if (empty()) { throw std::out_of_range("The container is empty."); }
+  if (first < cbegin() || last > cend()) { throw std::out_of_range("Invalid iterators provided."); }
+  const size_type idx = first - cbegin();
+  const size_type count = last - first;
+  if (count == 0) { return begin() + idx; }
+  pointer gap = m_storage + idx;
+  if constexpr (relocatable) {
+    destroy(gap, gap + count);
+    detail::move_bytes(gap, gap + count, m_end - idx - count);
+  } else {
+    std::move(gap + count, m_storage + m_end, gap);
+    destroy(m_storage + m_end - count, m_storage + m_end);
+  }
+  m_end -= count;
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes the element at `pos`.
+ *
+ * @param pos Iterator pointing to the position of the element to erase.
+ * @return An iterator pointing to the position of the erased element.
+ * @throws std::out_of_range if the container is empty or if the provided iterator is invalid.
+ */
+iterator erase(const_iterator pos){
+  return erase(pos, std::next(pos));
+}
+
+  // [V] Element access
+const_reference back() const {
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_storage[m_end - 1];
+}
+
+const_reference front() const{
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *m_storage;
+}
+
+reference back(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_storage[m_end - 1];
+}
+
+reference front(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return *m_storage;
+}
+
+const_reference operator[](size_type idx) const { return m_storage[idx]; }
+reference operator[](size_type idx) { return m_storage[idx]; }
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the small_vector is empty.
+ * @throws std::out_of_range if pos is not within the range of the small_vector.
+ */
+const_reference at(size_type pos) const {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_end) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return m_storage[pos];
+}
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the small_vector is empty.
+ * @throws std::out_of_range if pos is not within the range of the small_vector.
+ */
+reference at(size_type pos) {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_end) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return m_storage[pos];
+}
+
+pointer data() { return m_storage; }
+
+const_pointer data() const { return m_storage; }
+
+  // [VII] Friend functions.
+friend std::ostream &operator<<(std::ostream &os, const small_vector &vec) {
+  os << "{ ";
+  for (auto i{0U}; i < vec.m_end; ++i) {
+    os << vec.m_storage[i] << " ";
+  }
+  os << "| }, m_end=" << vec.m_end << ", m_capacity=" << vec.m_capacity
+     << (vec.is_inline() ? " (inline)" : " (heap)");
+  return os;
+}
+
+/// Swaps the contents; inline elements are moved, heap buffers are exchanged.
+friend void swap(small_vector &first, small_vector &second) {
+  small_vector tmp{std::move(first)};
+  first = std::move(second);
+  second = std::move(tmp);
+}
+
+private:
+/// How the elements are built and destroyed (see detail::alloc_ops).
+using element_ops = detail::alloc_ops<Allocator>;
+/// Whether elements may be moved around as raw bytes.
+static constexpr bool relocatable = element_ops::relocatable;
+
+element_ops ops() { return {m_alloc}; }
+
+pointer inline_data() { return reinterpret_cast<pointer>(m_inline); }
+const_pointer inline_data() const { return reinterpret_cast<const_pointer>(m_inline); }
+
+template <typename... Args>
+void construct_at(pointer p, Args &&...args){
+  alloc_traits::construct(m_alloc, p, std::forward<Args>(args)...);
+}
+
+void destroy_at(pointer p){ alloc_traits::destroy(m_alloc, p); }
+
+void destroy(pointer first, pointer last){ detail::destroy_range(ops(), first, last); }
+
+/// Gives the heap storage (if any) back to the allocator.
+void deallocate_heap(){
+  if (not is_inline()){ alloc_traits::deallocate(m_alloc, m_storage, m_capacity); }
+}
+
+/// Destroys every element and returns to the empty inline buffer.
+void reset_to_inline(){
+  clear();
+  deallocate_heap();
+  m_storage = inline_data();
+  m_capacity = N;
+}
+
+/// Takes the elements of `other` (this one must be empty and inline).
+void take(small_vector &other){
+  if (other.is_inline()){
+    relocate(other.m_storage, other.m_storage + other.m_end, m_storage);
+  } else {
+    m_storage = other.m_storage;
+    m_capacity = other.m_capacity;
+    other.m_storage = other.inline_data();
+    other.m_capacity = N;
+  }
+  m_end = other.m_end;
+  other.m_end = 0;
+}
+
+/// Constructs `n` elements read from `first` into the raw memory at `dest`.
+template <typename InputItr>
+void construct_copies(InputItr first, size_type n, pointer dest){
+  detail::construct_copies(ops(), first, n, dest);
+}
+
+/// Constructs `n` elements from the same `args` into the raw memory at `dest`.
+template <typename... Args>
+void construct_n(pointer dest, size_type n, const Args &...args){
+  detail::construct_n(ops(), dest, n, args...);
+}
+
+/// Transfers `[first, last)` to the raw memory at `dest`, leaving the source raw.
+void relocate(pointer first, pointer last, pointer dest){
+  detail::relocate(ops(), first, last, dest);
+}
+
+/// Moves the elements to a heap area of `new_cap` (> N) slots.
+void reallocate(size_type new_cap){
+  if constexpr (relocatable && detail::has_reallocate<Allocator>::value) {
+    if (not is_inline()){
+      m_storage = m_alloc.reallocate(m_storage, m_capacity, new_cap);
+      m_capacity = new_cap;
+      return;
+    }
+  }
+  pointer new_storage = alloc_traits::allocate(m_alloc, new_cap);
+  try {
+    relocate(m_storage, m_storage + m_end, new_storage);
+  } catch (...) {
+    alloc_traits::deallocate(m_alloc, new_storage, new_cap);
+    throw;
+  }
+  deallocate_heap();
+  m_storage = new_storage;
+  m_capacity = new_cap;
+}
+
+/// Inserts a new element at `idx` into a freshly grown heap area.
+template <typename... Args>
+void realloc_emplace(size_type idx, Args &&...args){
+  const size_type new_cap = growth_policy::next_capacity(m_capacity, m_end + 1);
+  pointer new_storage = alloc_traits::allocate(m_alloc, new_cap);
+  try {
+    construct_at(new_storage + idx, std::forward<Args>(args)...);
+  } catch (...) {
+    alloc_traits::deallocate(m_alloc, new_storage, new_cap);
+    throw;
+  }
+  // The old elements are only released once both halves made it across.
+  try {
+    detail::transfer_around(ops(), m_storage, m_end, idx, 1, new_storage);
+  } catch (...) {
+    destroy_at(new_storage + idx);
+    alloc_traits::deallocate(m_alloc, new_storage, new_cap);
+    throw;
+  }
+  detail::release_transferred(ops(), m_storage, m_storage + m_end);
+  deallocate_heap();
+
+  m_storage = new_storage;
+  m_capacity = new_cap;
+  ++m_end;
+}
+
+void grow_for(size_type required){
+  if (required <= m_capacity){ return; }
+  reserve(growth_policy::next_capacity(m_capacity, required));
+}
+
+/// Shifts `[idx, size())` `n` slots to the right, leaving `[idx, idx + n)` raw.
+void open_gap(size_type idx, size_type n){ detail::open_gap(ops(), m_storage, m_end, idx, n); }
+
+/// Undoes open_gap(idx, n) when the raw gap could not be filled.
+void close_gap(size_type idx, size_type n){ detail::close_gap(ops(), m_storage, m_end, idx, n); }
+
+/// Replaces the contents with `n` elements read from `first`.
+template <typename InputItr>
+void assign_n(InputItr first, size_type n){
+  if (n > m_capacity) {
+    clear();
+    grow_for(n);
+  }
+  detail::assign_n(ops(), m_storage, m_end, first, n);
+  m_end = n;
+}
+
+  size_type m_end;      //!< The current size.
+  size_type m_capacity; //!< N while inline, the heap capacity otherwise.
+  T *m_storage;         //!< Either the inline buffer or the heap area.
+  Allocator m_alloc;    //!< Where the heap area comes from.
+  alignas(T) std::byte m_inline[N * sizeof(T)]; //!< Raw inline storage.
+};
+
+template <typename T, std::size_t N, typename A, typename G>
+bool operator==(const small_vector<T, N, A, G> &lhs, const small_vector<T, N, A, G> &rhs) {
+  if (lhs.size() != rhs.size()) { return false; }
+  for (typename small_vector<T, N, A, G>::size_type i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) { return false; }
+  }
+  return true;
+}
+
+template <typename T, std::size_t N, typename A, typename G>
+bool operator!=(const small_vector<T, N, A, G> &lhs, const small_vector<T, N, A, G> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,202 @@
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "small_vector.h"
+#include "test_types.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+using sc_test::Fragile;
+
+// =============================================================
+// Tests for sc::small_vector
+// =============================================================
+
+// Up to N elements stay in the inline buffer.
+#define SMALL_INLINE YES
+// Growing past N spills to the heap, shrink_to_fit() brings them back.
+#define SMALL_SPILL YES
+// insert()/erase() on inline and heap storage.
+#define SMALL_INSERT_ERASE YES
+// Copy and move, inline and on the heap.
+#define SMALL_COPY_MOVE YES
+// swap() between inline and heap small_vectors.
+#define SMALL_SWAP YES
+// A throwing copy in insert() or in a reallocation changes nothing.
+#define SMALL_ROLLBACK YES
+
+namespace {
+/// Tells whether the elements of `vec` sit inside the object itself.
+template <typename Vector> bool stored_in_object(const Vector &vec) {
+  auto first = reinterpret_cast<const std::byte *>(vec.data());
+  auto self = reinterpret_cast<const std::byte *>(&vec);
+  return first >= self and first < self + sizeof(vec);
+}
+
+/// Tells whether `vec` holds 0, 1, ..., size() - 1.
+template <typename Vector> bool holds_iota(const Vector &vec) {
+  for (std::size_t i{0}; i < vec.size(); ++i)
+    if (vec[i].value != int(i)) { return false; }
+  return true;
+}
+} // namespace
+
+void run_small_vector_tests(void) {
+  TestManager tm{"small_vector testing"};
+
+#if SMALL_INLINE
+  {
+    BEGIN_TEST(tm, "SmallInline", "small_vector<int, 8>{1, 2, 3}");
+    sc::small_vector<int, 8> vec{1, 2, 3};
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_TRUE(stored_in_object(vec));
+    EXPECT_EQ(vec.capacity(), 8u);
+    for (int i{4}; i <= 8; ++i)
+      vec.push_back(i);
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(vec.size(), 8u);
+    EXPECT_EQ(vec.back(), 8);
+    EXPECT_EQ(vec, (sc::small_vector<int, 8>{1, 2, 3, 4, 5, 6, 7, 8}));
+  }
+#endif
+
+#if SMALL_SPILL
+  {
+    BEGIN_TEST(tm, "SmallSpill", "push_back past N, then shrink_to_fit()");
+    sc::small_vector<std::string, 4> vec{"a", "b", "c", "d"};
+    vec.push_back("e");
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_FALSE(stored_in_object(vec));
+    EXPECT_EQ(vec.capacity(), 8u);
+    EXPECT_EQ(vec[0], "a");
+    EXPECT_EQ(vec[4], "e");
+
+    vec.erase(vec.begin() + 1, vec.begin() + 3);
+    vec.shrink_to_fit();
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(vec.capacity(), 4u);
+    EXPECT_EQ(vec, (sc::small_vector<std::string, 4>{"a", "d", "e"}));
+
+    sc::small_vector<int, 2> big(100);
+    EXPECT_EQ(big.size(), 100u);
+    EXPECT_EQ(big.capacity(), 100u);
+  }
+#endif
+
+#if SMALL_INSERT_ERASE
+  {
+    BEGIN_TEST(tm, "SmallInsertErase", "insert(), emplace(), erase(), pop_front()");
+    sc::small_vector<std::string, 6> vec{"1", "2", "3"};
+    vec.insert(vec.begin() + 1, {"x", "y"});
+    vec.emplace(vec.begin(), 2, 'z');
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(vec, (sc::small_vector<std::string, 6>{"zz", "1", "x", "y", "2", "3"}));
+    vec.push_front(vec.back()); // spills over while reading its own element.
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_EQ(vec.front(), "3");
+    vec.pop_front();
+    vec.erase(vec.begin() + 2);
+    vec.pop_back();
+    EXPECT_EQ(vec, (sc::small_vector<std::string, 6>{"zz", "1", "y", "2"}));
+    vec.assign(size_t(3), "k");
+    EXPECT_EQ(vec.size(), 3u);
+    EXPECT_EQ(vec.at(2), "k");
+  }
+#endif
+
+#if SMALL_COPY_MOVE
+  {
+    BEGIN_TEST(tm, "SmallCopyMove", "copy and move, inline and heap");
+    sc::small_vector<std::string, 3> inl{"a", "b"};
+    sc::small_vector<std::string, 3> heap{"a", "b", "c", "d"};
+
+    auto inl_copy{inl};
+    auto heap_copy{heap};
+    EXPECT_EQ(inl_copy, inl);
+    EXPECT_EQ(heap_copy, heap);
+    EXPECT_TRUE(inl_copy.is_inline());
+
+    const auto *heap_data = heap.data();
+    auto heap_moved{std::move(heap)};
+    EXPECT_TRUE(heap_moved.data() == heap_data); // buffer taken over.
+    EXPECT_TRUE(heap.empty());
+    EXPECT_TRUE(heap.is_inline());
+
+    auto inl_moved{std::move(inl)};
+    EXPECT_EQ(inl_moved, inl_copy);
+    EXPECT_TRUE(inl.empty());
+
+    inl = heap_moved;
+    EXPECT_EQ(inl.size(), 4u);
+    heap_moved = std::move(inl_moved);
+    EXPECT_EQ(heap_moved, inl_copy);
+    heap = std::move(inl);
+    EXPECT_EQ(heap, heap_copy);
+  }
+#endif
+
+#if SMALL_SWAP
+  {
+    BEGIN_TEST(tm, "SmallSwap", "swap(inline, heap)");
+    sc::small_vector<int, 4> a{1, 2};
+    sc::small_vector<int, 4> b{1, 2, 3, 4, 5, 6};
+    swap(a, b);
+    EXPECT_EQ(a.size(), 6u);
+    EXPECT_FALSE(a.is_inline());
+    EXPECT_EQ(b, (sc::small_vector<int, 4>{1, 2}));
+    EXPECT_TRUE(b.is_inline());
+  }
+#endif
+
+#if SMALL_ROLLBACK
+  {
+    BEGIN_TEST(tm, "SmallRollback", "insert() and a reallocating emplace() whose copy throws");
+    Fragile::alive = 0;
+    {
+      const Fragile source[]{Fragile{10}, Fragile{11}, Fragile{12}};
+      for (std::size_t at : {1u, 3u}) {
+        sc::small_vector<Fragile, 16> vec;
+        for (int i{0}; i < 4; ++i)
+          vec.emplace_back(i);
+        Fragile::copies_left = 2;
+        bool thrown{false};
+        try {
+          vec.insert(vec.begin() + at, std::begin(source), std::end(source));
+        } catch (const std::runtime_error &) {
+          thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+        EXPECT_EQ(vec.size(), 4u);
+        EXPECT_TRUE(holds_iota(vec));
+        EXPECT_EQ(Fragile::alive, 3 + 4);
+      }
+      // Full, so emplace() relocates [0, 2) and then [2, 4) to the heap.
+      for (int budget : {1, 3}) {
+        sc::small_vector<Fragile, 4> vec;
+        for (int i{0}; i < 4; ++i)
+          vec.emplace_back(i);
+        Fragile::copies_left = budget;
+        bool thrown{false};
+        try {
+          vec.emplace(vec.begin() + 2, 42);
+        } catch (const std::runtime_error &) {
+          thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+        EXPECT_TRUE(vec.is_inline());
+        EXPECT_EQ(vec.size(), 4u);
+        EXPECT_TRUE(holds_iota(vec));
+        EXPECT_EQ(Fragile::alive, 3 + 4);
+      }
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
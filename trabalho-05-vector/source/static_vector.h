@@ -0,0 +1,592 @@
+#ifndef _STATIC_VECTOR_H_
+#define _STATIC_VECTOR_H_
+
+#include "vector.h" // sc::MyForwardIterator
+
+/// Sequence container namespace.
+namespace sc {
+
+namespace detail {
+
+/// Element policy of a storage area whose slots always hold objects.
+/*!
+ * "Constructing" an element is an assignment and destroying one is a no-op,
+ * so the element helpers may run in constant expressions.
+ */
+template <typename T>
+struct assign_ops {
+  using value_type = T;
+
+  static constexpr bool relocatable = is_trivially_relocatable_v<T>;
+  static constexpr bool bitwise_copyable = std::is_trivially_copyable_v<T>;
+  static constexpr bool trivial_destroy = true;
+
+  template <typename... Args>
+  constexpr void construct(T *p, Args &&...args) const {
+    if constexpr (std::is_constructible_v<T, Args...>) {
+      *p = T(std::forward<Args>(args)...);
+    } else {
+      *p = T{std::forward<Args>(args)...};
+    }
+  }
+
+  constexpr void destroy(T *) const {}
+};
+
+/// Element storage of a static_vector of trivial elements.
+/*!
+ * A plain array, so the whole container is a literal type and may be used in
+ * constant expressions. Slots past the end hold objects too; "constructing"
+ * an element is an assignment and destroying it is a no-op. The copy and
+ * move operations are the implicit, byte-wise ones.
+ */
+template <typename T, std::size_t N, bool = std::is_trivial_v<T>>
+class static_vector_storage {
+protected:
+  /// A constexpr static_vector must not leave any slot uninitialized; at run
+  /// time the slots past the end are written before they are read, so the
+  /// array is not zeroed there.
+  constexpr static_vector_storage() {
+    if (std::is_constant_evaluated()) {
+      for (auto &slot : m_data)
+        slot = T{};
+    }
+  }
+
+  using element_ops = assign_ops<T>;
+
+  static constexpr element_ops ops() { return {}; }
+
+  constexpr T *slots() { return m_data; }
+  constexpr const T *slots() const { return m_data; }
+
+  template <typename... Args>
+  constexpr void construct_at(T *p, Args &&...args) {
+    ops().construct(p, std::forward<Args>(args)...);
+  }
+
+  constexpr void destroy(T *, T *) {}
+
+  T m_data[N];            //!< The elements.
+  std::size_t m_end{0};   //!< The current size.
+};
+
+/// Element storage of a static_vector of non-trivial elements.
+/*!
+ * Raw, suitably aligned bytes: only the slots in `[0, m_end)` hold live
+ * objects. Copying and moving work element by element.
+ */
+template <typename T, std::size_t N>
+class static_vector_storage<T, N, false> {
+protected:
+  static_vector_storage() noexcept {}
+
+  static_vector_storage(const static_vector_storage &other) {
+    replace_with(other.slots(), other.m_end);
+  }
+
+  static_vector_storage(static_vector_storage &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    replace_with(std::make_move_iterator(other.slots()), other.m_end);
+  }
+
+  static_vector_storage &operator=(const static_vector_storage &rhs) {
+    if (this != &rhs) { replace_with(rhs.slots(), rhs.m_end); }
+    return *this;
+  }
+
+  static_vector_storage &operator=(static_vector_storage &&rhs) noexcept(
+      std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+    if (this != &rhs) { replace_with(std::make_move_iterator(rhs.slots()), rhs.m_end); }
+    return *this;
+  }
+
+  ~static_vector_storage() { destroy(slots(), slots() + m_end); }
+
+  using element_ops = placement_ops<T>;
+
+  static element_ops ops() { return {}; }
+
+  T *slots() { return std::launder(reinterpret_cast<T *>(m_raw)); }
+  const T *slots() const { return std::launder(reinterpret_cast<const T *>(m_raw)); }
+
+  template <typename... Args>
+  void construct_at(T *p, Args &&...args) {
+    ops().construct(p, std::forward<Args>(args)...);
+  }
+
+  void destroy(T *first, T *last) { destroy_range(ops(), first, last); }
+
+  /// Replaces the elements with `n` elements read from `first` (`n <= N`).
+  template <typename InputItr>
+  void replace_with(InputItr first, std::size_t n) {
+    assign_n(ops(), slots(), m_end, first, n);
+    m_end = n;
+  }
+
+  alignas(T) std::byte m_raw[N * sizeof(T)]; //!< Raw storage for the elements.
+  std::size_t m_end{0};                      //!< The current size.
+};
+
+} // namespace detail.
+
+/// Vector with a fixed, inline capacity that never allocates.
+/*!
+ * sc::static_vector offers the modifiers of sc::vector, but its storage is an
+ * array of `N` slots inside the object itself: no operation ever touches the
+ * heap, and the capacity is always `N`. Growing past it throws
+ * `std::length_error`.
+ *
+ * For trivial element types (e.g. `int` or a POD struct) the storage is a
+ * plain array and every member function is `constexpr`, so a static_vector
+ * may be built and used at compile time.
+ *
+ * \tparam T The type of the elements.
+ * \tparam N The (fixed) capacity.
+ */
+template <typename T, std::size_t N>
+class static_vector : private detail::static_vector_storage<T, N> {
+  static_assert(N > 0, "a static_vector must have room for at least one element");
+  using storage = detail::static_vector_storage<T, N>;
+  using storage::construct_at;
+  using storage::destroy;
+  using storage::m_end;
+  using storage::ops;
+  using storage::slots;
+
+  //=== Aliases
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using const_pointer = const value_type *; //!< Pointer to a const value.
+  using reference = value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value stored in the container.
+  using iterator = MyForwardIterator<value_type>; //!< The iterator.
+  using const_iterator = MyForwardIterator<const value_type>; //!< The const_iterator.
+
+  //=== [I] SPECIAL MEMBERS
+  // Copy, move and destruction come from the storage.
+/**
+ * @brief Constructs an empty static_vector.
+ */
+constexpr static_vector() = default;
+
+/**
+ * @brief Constructs a static_vector with `count` value-initialized elements.
+ *
+ * @param count The initial size.
+ * @throws std::length_error if `count > N`.
+ */
+constexpr explicit static_vector(size_type count) {
+  check_room(count);
+  for (; m_end < count; ++m_end) { construct_at(slots() + m_end); }
+}
+
+/**
+ * @brief Constructs a static_vector with the elements of an initializer list.
+ *
+ * @param il The initializer list.
+ * @throws std::length_error if the list is longer than `N`.
+ */
+constexpr static_vector(const std::initializer_list<T> &il)
+  : static_vector(il.begin(), il.end()) {}
+
+/**
+ * @brief Constructs a static_vector from the range [first, last).
+ *
+ * @param first Iterator to the beginning of the range.
+ * @param last Iterator to the end of the range.
+ * @throws std::length_error if the range is longer than `N`.
+ */
+template <typename InputItr>
+constexpr static_vector(InputItr first, InputItr last) {
+  assign(first, last);
+}
+
+  //=== [II] ITERATORS
+constexpr iterator begin() { return iterator{slots()}; }
+constexpr iterator end() { return iterator(slots() + m_end); }
+constexpr const_iterator begin() const { return const_iterator(slots()); }
+constexpr const_iterator end() const { return const_iterator(slots() + m_end); }
+constexpr const_iterator cbegin() const { return const_iterator(slots()); }
+constexpr const_iterator cend() const { return const_iterator(slots() + m_end); }
+
+  // [III] Capacity
+[[nodiscard]] constexpr bool full() const { return m_end == N; }
+[[nodiscard]] constexpr size_type size() const { return m_end; }
+[[nodiscard]] static constexpr size_type capacity() { return N; }
+[[nodiscard]] static constexpr size_type max_size() { return N; }
+[[nodiscard]] constexpr bool empty() const { return m_end == 0; }
+
+  // [IV] Modifiers
+constexpr void clear(){
+  destroy(slots(), slots() + m_end);
+  m_end = 0;
+}
+
+/**
+ * @brief Inserts an element at the beginning.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the static_vector is full.
+ */
+constexpr void push_front(const_reference value){ emplace(cbegin(), value); }
+
+/**
+ * @brief Inserts an element at the beginning, moving it in.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the static_vector is full.
+ */
+constexpr void push_front(value_type &&value){ emplace(cbegin(), std::move(value)); }
+
+/**
+ * @brief Inserts an element at the end.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the static_vector is full.
+ */
+constexpr void push_back(const_reference value){ emplace_back(value); }
+
+/**
+ * @brief Inserts an element at the end, moving it in.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the static_vector is full.
+ */
+constexpr void push_back(value_type &&value){ emplace_back(std::move(value)); }
+
+/**
+ * @brief Constructs an element in place at the end.
+ *
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ * @throws std::length_error if the static_vector is full.
+ */
+template <typename... Args>
+constexpr reference emplace_back(Args &&...args){
+  check_room(m_end + 1);
+  construct_at(slots() + m_end, std::forward<Args>(args)...);
+  return slots()[m_end++];
+}
+
+/**
+ * @brief Constructs an element in place right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return An iterator pointing to the new element.
+ * @throws std::length_error if the static_vector is full.
+ */
+template <typename... Args>
+constexpr iterator emplace(const_iterator pos, Args &&...args){
+  const size_type idx = pos - cbegin();
+  check_room(m_end + 1);
+  if (idx == m_end){
+    construct_at(slots() + m_end, std::forward<Args>(args)...);
+  } else {
+    // The arguments may refer to an element that is about to be shifted.
+    value_type tmp(std::forward<Args>(args)...);
+    open_gap(idx, 1);
+    try {
+      construct_at(slots() + idx, std::move(tmp));
+    } catch (...) {
+      close_gap(idx, 1);
+      throw;
+    }
+  }
+  ++m_end;
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes the last element.
+ *
+ * @throws std::length_error if the static_vector is empty.
+ */
+constexpr void pop_back(){
+  if(empty()){throw std::length_error("POP_BACK(EMPTY)\n");}
+  --m_end;
+  destroy(slots() + m_end, slots() + m_end + 1);
+}
+
+/**
+ * @brief Removes the first element.
+ *
+ * @throws std::length_error if the static_vector is empty.
+ */
+constexpr void pop_front(){
+  if(empty()){throw std::length_error("POP_FRONT(EMPTY)\n");}
+  erase(cbegin());
+}
+
+/**
+ * @brief Inserts the range [first, last) right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the elements will be inserted.
+ * @param first Iterator to the beginning of the range of elements to insert.
+ * @param last Iterator to the end of the range of elements to insert.
+ * @return An iterator pointing to the first inserted element, or pos if the range is empty.
+ * @throws std::length_error if the elements do not fit.
+ */
+template<typename InputItr>
+constexpr iterator insert(const_iterator pos, InputItr first, InputItr last){
+  const size_type idx = pos - cbegin();
+  const size_type count = std::distance(first, last);
+  check_room(m_end + count);
+  open_gap(idx, count);
+  size_type i{0};
+  try {
+    for (; i < count; ++i, ++first){
+      construct_at(slots() + idx + i, *first);
+    }
+  } catch (...) {
+    destroy(slots() + idx, slots() + idx + i);
+    close_gap(idx, count);
+    throw;
+  }
+  m_end += count;
+  return begin() + idx;
+}
+
+/**
+ * @brief Inserts the elements of `ilist` right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the elements will be inserted.
+ * @param ilist Initializer list containing elements to insert.
+ * @return An iterator pointing to the first inserted element, or pos if the list is empty.
+ * @throws std::length_error if the elements do not fit.
+ */
+constexpr iterator insert(const_iterator pos, const std::initializer_list<value_type> &ilist){
+  return insert(pos, ilist.begin(), ilist.end());
+}
+
+/**
+ * @brief Inserts a copy of `value` right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param value The value to be inserted.
+ * @return An iterator pointing to the inserted element.
+ * @throws std::length_error if the static_vector is full.
+ */
+constexpr iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+
+/**
+ * @brief Moves `value` in right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param value The value to be inserted.
+ * @return An iterator pointing to the inserted element.
+ * @throws std::length_error if the static_vector is full.
+ */
+constexpr iterator insert(const_iterator pos, value_type &&value) { return emplace(pos, std::move(value)); }
+
+/**
+ * @brief Checks that `new_cap` elements fit; nothing is ever allocated.
+ *
+ * @param new_cap The requested capacity.
+ * @throws std::length_error if `new_cap > N`.
+ */
+constexpr void reserve(size_type new_cap) const { check_room(new_cap); }
+
+/// Does nothing: the capacity is fixed.
+constexpr void shrink_to_fit() const {}
+
+/**
+ * @brief Replaces the contents with the elements from [first, last).
+ *
+ * @param first Iterator to the beginning of the range of elements to assign.
+ * @param last Iterator to the end of the range of elements to assign.
+ * @throws std::length_error if the range is longer than `N`.
+ */
+template <typename InputItr>
+constexpr void assign(InputItr first, InputItr last) {
+  const size_type count = std::distance(first, last);
+  check_room(count);
+  detail::assign_n(ops(), slots(), m_end, first, count);
+  m_end = count;
+}
+
+/**
+ * @brief Replaces the contents with `count` copies of `value`.
+ *
+ * @param count The number of elements to assign.
+ * @param value The value to assign to the elements.
+ * @throws std::length_error if `count > N`.
+ */
+constexpr void assign(size_type count, const_reference value) {
+  check_room(count);
+  size_type i{0};
+  for (; i < count and i < m_end; ++i){ slots()[i] = value; }
+  for (; i < count; ++i, ++m_end){ construct_at(slots() + i, value); }
+  destroy(slots() + count, slots() + m_end);
+  m_end = count;
+}
+
+/**
+ * @brief Replaces the contents with the elements of `ilist`.
+ *
+ * @param ilist Initializer list containing elements to assign.
+ * @throws std::length_error if the list is longer than `N`.
+ */
+constexpr void assign(const std::initializer_list<T> &ilist) {
+  assign(ilist.begin(), ilist.end());
+}
+
+/**
+ * @brief Removes the elements in [first, last).
+ *
+ * @param first Iterator pointing to the beginning of the range to erase.
+ * @param last Iterator pointing to the end of the range to erase.
+ * @return An iterator pointing to the position of the first erased element.
+ * @throws std::out_of_range if the container is empty or if the provided iterators are invalid.
+ */
+constexpr iterator erase(const_iterator first, const_iterator last) {
+  if (empty()) { throw std::out_of_range("The container is empty."); }
+  if (first < cbegin() || last > cend()) { throw std::out_of_range("Invalid iterators provided."); }
+  const size_type idx = first - cbegin();
+  const size_type count = last - first;
+  if (count == 0) { return begin() + idx; }
+  pointer data = slots();
+  for (size_type i = idx + count; i < m_end; ++i){ data[i - count] = std::move(data[i]); }
+  destroy(data + m_end - count, data + m_end);
+  m_end -= count;
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes the element at `pos`.
+ *
+ * @param pos Iterator pointing to the position of the element to erase.
+ * @return An iterator pointing to the position of the erased element.
+ * @throws std::out_of_range if the container is empty or if the provided iterator is invalid.
+ */
+constexpr iterator erase(const_iterator pos){ return erase(pos, pos + 1); }
+
+  // [V] Element access
+constexpr const_reference back() const {
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return slots()[m_end - 1];
+}
+
+constexpr const_reference front() const{
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return slots()[0];
+}
+
+constexpr reference back(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return slots()[m_end - 1];
+}
+
+constexpr reference front(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return slots()[0];
+}
+
+constexpr const_reference operator[](size_type idx) const { return slots()[idx]; }
+constexpr reference operator[](size_type idx) { return slots()[idx]; }
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the static_vector is empty.
+ * @throws std::out_of_range if pos is not within the range of the static_vector.
+ */
+constexpr const_reference at(size_type pos) const {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_end) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return slots()[pos];
+}
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the static_vector is empty.
+ * @throws std::out_of_range if pos is not within the range of the static_vector.
+ */
+constexpr reference at(size_type pos) {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_end) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return slots()[pos];
+}
+
+constexpr pointer data() { return slots(); }
+
+constexpr const_pointer data() const { return slots(); }
+
+  // [VII] Friend functions.
+friend std::ostream &operator<<(std::ostream &os, const static_vector &vec) {
+  os << "{ ";
+  for (auto i{0U}; i < vec.m_end; ++i) {
+    os << vec[i] << " ";
+  }
+  os << "| }, m_end=" << vec.m_end << ", m_capacity=" << N;
+  return os;
+}
+
+/// Swaps the contents element by element (O(size())).
+friend constexpr void swap(static_vector &first, static_vector &second) {
+  static_vector tmp{std::move(first)};
+  first = std::move(second);
+  second = std::move(tmp);
+}
+
+private:
+/// Throws when `count` elements would not fit.
+static constexpr void check_room(size_type count) {
+  if (count > N) { throw std::length_error("static_vector capacity exceeded"); }
+}
+
+/**
+ * @brief Shifts `[idx, size())` `n` slots to the right.
+ *
+ * On return the slots `[idx, idx + n)` hold no live object. The caller must
+ * have checked that `size() + n <= N`.
+ */
+constexpr void open_gap(size_type idx, size_type n){
+  detail::open_gap(ops(), slots(), m_end, idx, n);
+}
+
+/// Undoes open_gap(idx, n) when the gap could not be filled (see detail::close_gap).
+constexpr void close_gap(size_type idx, size_type n){
+  detail::close_gap(ops(), slots(), m_end, idx, n);
+}
+};
+
+template <typename T, std::size_t N>
+constexpr bool operator==(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+  if (lhs.size() != rhs.size()) { return false; }
+  for (typename static_vector<T, N>::size_type i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) { return false; }
+  }
+  return true;
+}
+
+template <typename T, std::size_t N>
+constexpr bool operator!=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+  return !(lhs == rhs);
+}
+
+/// sc::static_vector under the name `vector`, to swap it in with `which_lib`.
+/*!
+ * Tests and benchmarks written against `which_lib::vector<T>` run on the
+ * fixed-capacity container with `#define which_lib sc::fixed_capacity`.
+ */
+namespace fixed_capacity {
+/// Capacity used when none is given.
+inline constexpr std::size_t default_capacity = 128;
+
+template <typename T, std::size_t N = default_capacity>
+using vector = static_vector<T, N>;
+} // namespace fixed_capacity.
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,171 @@
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "static_vector.h"
+#include "test_types.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+using sc_test::Fragile;
+
+// =============================================================
+// Tests for sc::static_vector
+// =============================================================
+
+// Capacity is fixed and the elements live inside the object.
+#define STATIC_INLINE YES
+// Going past N throws std::length_error and leaves the vector untouched.
+#define STATIC_OVERFLOW YES
+// The sc::vector modifiers, on a non-trivial type.
+#define STATIC_MODIFIERS YES
+// Copy, move and swap.
+#define STATIC_COPY_MOVE YES
+// Trivial elements can be used at compile time.
+#define STATIC_CONSTEXPR YES
+// A throwing copy in insert() leaves the vector as it was.
+#define STATIC_INSERT_ROLLBACK YES
+
+namespace {
+/// Builds {0, 10, 20, 30} the long way, at compile time.
+constexpr sc::static_vector<int, 8> make_tens() {
+  sc::static_vector<int, 8> vec{20, 99, 99};
+  vec.push_back(30);
+  vec.push_front(0);
+  vec.erase(vec.cbegin() + 2, vec.cbegin() + 4);
+  vec.insert(vec.cbegin() + 1, 10);
+  return vec;
+}
+
+constexpr int sum(const sc::static_vector<int, 8> &vec) {
+  int total{0};
+  for (auto it = vec.cbegin(); it != vec.cend(); ++it)
+    total += *it;
+  return total;
+}
+} // namespace
+
+void run_static_vector_tests(void) {
+  TestManager tm{"static_vector testing"};
+
+#if STATIC_INLINE
+  {
+    BEGIN_TEST(tm, "StaticInline", "static_vector<int, 16>");
+    sc::static_vector<int, 16> vec{1, 2, 3};
+    EXPECT_EQ(vec.capacity(), 16u);
+    EXPECT_EQ(vec.size(), 3u);
+    auto first = reinterpret_cast<const std::byte *>(vec.data());
+    auto self = reinterpret_cast<const std::byte *>(&vec);
+    EXPECT_TRUE(first >= self and first < self + sizeof(vec));
+    for (int i{4}; i <= 16; ++i)
+      vec.push_back(i);
+    EXPECT_TRUE(vec.full());
+    EXPECT_EQ(vec.back(), 16);
+  }
+#endif
+
+#if STATIC_OVERFLOW
+  {
+    BEGIN_TEST(tm, "StaticOverflow", "push_back()/insert() on a full static_vector");
+    sc::static_vector<std::string, 3> vec{"a", "b", "c"};
+    bool thrown{false};
+    try { vec.push_back("d"); } catch (const std::length_error &) { thrown = true; }
+    EXPECT_TRUE(thrown);
+    thrown = false;
+    try { vec.insert(vec.cbegin(), {"x", "y"}); } catch (const std::length_error &) { thrown = true; }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(vec, (sc::static_vector<std::string, 3>{"a", "b", "c"}));
+  }
+#endif
+
+#if STATIC_MODIFIERS
+  {
+    BEGIN_TEST(tm, "StaticModifiers", "insert(), emplace(), erase(), assign()");
+    sc::static_vector<std::string, 10> vec{"1", "2", "3"};
+    vec.insert(vec.cbegin() + 1, {"x", "y"});
+    vec.emplace(vec.cbegin(), 2, 'z');
+    vec.push_front(vec.back());
+    EXPECT_EQ(vec, (sc::static_vector<std::string, 10>{"3", "zz", "1", "x", "y", "2", "3"}));
+    vec.pop_front();
+    vec.erase(vec.cbegin() + 2);
+    vec.pop_back();
+    EXPECT_EQ(vec, (sc::static_vector<std::string, 10>{"zz", "1", "y", "2"}));
+    auto it = vec.erase(vec.cbegin() + 1, vec.cbegin() + 1);
+    EXPECT_EQ(it, vec.begin() + 1);
+    EXPECT_EQ(vec, (sc::static_vector<std::string, 10>{"zz", "1", "y", "2"}));
+    vec.assign(size_t(6), "k");
+    EXPECT_EQ(vec.size(), 6u);
+    EXPECT_EQ(vec.at(5), "k");
+    vec.assign({"p", "q"});
+    EXPECT_EQ(vec.size(), 2u);
+    EXPECT_EQ(vec.front(), "p");
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+  }
+#endif
+
+#if STATIC_COPY_MOVE
+  {
+    BEGIN_TEST(tm, "StaticCopyMove", "copy, move and swap");
+    sc::static_vector<std::string, 4> a{"a", "b", "c"};
+    auto copy{a};
+    EXPECT_EQ(copy, a);
+    auto moved{std::move(a)};
+    EXPECT_EQ(moved, copy);
+    sc::static_vector<std::string, 4> b{"z"};
+    b = moved;
+    EXPECT_EQ(b, copy);
+    b = sc::static_vector<std::string, 4>{"q", "r"};
+    swap(b, copy);
+    EXPECT_EQ(b.size(), 3u);
+    EXPECT_EQ(copy, (sc::static_vector<std::string, 4>{"q", "r"}));
+  }
+#endif
+
+#if STATIC_CONSTEXPR
+  {
+    BEGIN_TEST(tm, "StaticConstexpr", "constexpr static_vector<int, 8>");
+    constexpr auto tens = make_tens();
+    static_assert(tens.size() == 4);
+    static_assert(tens[3] == 30);
+    static_assert(sum(tens) == 60);
+    constexpr sc::static_vector<int, 4> listed{1, 2};
+    static_assert(listed.size() == 2 and listed[1] == 2);
+    EXPECT_EQ(tens, (sc::static_vector<int, 8>{0, 10, 20, 30}));
+  }
+#endif
+
+#if STATIC_INSERT_ROLLBACK
+  {
+    BEGIN_TEST(tm, "StaticInsertRollback", "insert(pos, first, last) whose 3rd copy throws");
+    Fragile::alive = 0;
+    {
+      const Fragile source[]{Fragile{10}, Fragile{11}, Fragile{12}};
+      for (std::size_t at : {1u, 3u}) {
+        sc::static_vector<Fragile, 16> vec;
+        for (int i{0}; i < 4; ++i)
+          vec.emplace_back(i);
+        Fragile::copies_left = 2;
+        bool thrown{false};
+        try {
+          vec.insert(vec.cbegin() + at, std::begin(source), std::end(source));
+        } catch (const std::runtime_error &) {
+          thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+        EXPECT_EQ(vec.size(), 4u);
+        for (int i{0}; i < 4; ++i)
+          EXPECT_EQ(vec[i].value, i);
+        EXPECT_EQ(Fragile::alive, 3 + 4);
+      }
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,238 @@
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "test_types.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+using sc_test::Fragile;
+using sc_test::Handle;
+using sc_test::Tracked;
+
+// =============================================================
+// Tests for the lifetime of the elements kept in the raw storage
+// =============================================================
+
+// reserve() must not construct any element.
+#define RESERVE_NO_CTOR YES
+// The size ctor constructs each element exactly once.
+#define SIZE_CTRO_ONCE YES
+// Only the live elements are destroyed.
+#define DESTROY_LIVE_ONLY YES
+// Elements removed by pop/erase/clear are destroyed right away.
+#define DESTROY_ON_REMOVE YES
+// insert() keeps the number of live objects consistent.
+#define INSERT_LIFETIME YES
+// Trivially copyable elements take the memcpy/memmove/realloc paths.
+#define TRIVIAL_FAST_PATHS YES
+// Types that opt in to sc::is_trivially_relocatable are never move-constructed.
+#define RELOCATABLE_OPT_IN YES
+// A throwing copy in insert() leaves the vector as it was.
+#define INSERT_ROLLBACK YES
+
+namespace {
+/// Plain old data record.
+struct Point {
+  int x, y;
+  bool operator==(const Point &rhs) const { return x == rhs.x and y == rhs.y; }
+  bool operator!=(const Point &rhs) const { return not(*this == rhs); }
+};
+} // namespace
+
+void run_storage_tests(void) {
+  TestManager tm{"Raw storage testing"};
+
+#if RESERVE_NO_CTOR
+  {
+    BEGIN_TEST(tm, "ReserveNoCtor", "vec.reserve(1'000'000)");
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec;
+      vec.reserve(1'000'000);
+      EXPECT_EQ(vec.capacity(), 1'000'000u);
+      EXPECT_EQ(Tracked::constructed, 0);
+
+      sc::vector<std::string> vec2;
+      vec2.reserve(1'000'000);
+      EXPECT_TRUE(vec2.empty());
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if SIZE_CTRO_ONCE
+  {
+    BEGIN_TEST(tm, "SizeCtroOnce", "vector<T> vec(10)");
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec(10);
+      EXPECT_EQ(Tracked::constructed, 10);
+      EXPECT_EQ(Tracked::alive, 10);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if DESTROY_LIVE_ONLY
+  {
+    BEGIN_TEST(tm, "DestroyLiveOnly", "~vector() with spare capacity");
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec;
+      vec.reserve(100);
+      for (int i{0}; i < 3; ++i)
+        vec.push_back(Tracked{i});
+      EXPECT_EQ(Tracked::alive, 3);
+      vec.shrink_to_fit();
+      EXPECT_EQ(vec.capacity(), 3u);
+      EXPECT_EQ(Tracked::alive, 3);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if DESTROY_ON_REMOVE
+  {
+    BEGIN_TEST(tm, "DestroyOnRemove", "pop_back(), pop_front(), erase(), clear()");
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec{1, 2, 3, 4, 5, 6};
+      EXPECT_EQ(Tracked::alive, 6);
+      vec.pop_back();
+      EXPECT_EQ(Tracked::alive, 5);
+      vec.pop_front();
+      EXPECT_EQ(Tracked::alive, 4);
+      EXPECT_EQ(vec.front().value, 2);
+      vec.erase(vec.begin(), vec.begin() + 2);
+      EXPECT_EQ(Tracked::alive, 2);
+      EXPECT_EQ(vec.front().value, 4);
+      vec.assign(size_t(1), Tracked{9});
+      EXPECT_EQ(Tracked::alive, 1);
+      vec.clear();
+      EXPECT_EQ(Tracked::alive, 0);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if INSERT_LIFETIME
+  {
+    BEGIN_TEST(tm, "InsertLifetime", "vec.insert(pos, first, last)");
+    Tracked::reset();
+    {
+      sc::vector<Tracked> vec{1, 2, 3, 4, 5};
+      vec.reserve(20);
+      sc::vector<Tracked> src{7, 8};
+      // Gap smaller than the tail.
+      vec.insert(vec.begin() + 1, src.begin(), src.end());
+      EXPECT_EQ(Tracked::alive, 9);
+      EXPECT_EQ(vec, (sc::vector<Tracked>{1, 7, 8, 2, 3, 4, 5}));
+      // Gap wider than the tail.
+      vec.insert(vec.begin() + 6, {10, 11, 12});
+      EXPECT_EQ(Tracked::alive, 12);
+      EXPECT_EQ(vec, (sc::vector<Tracked>{1, 7, 8, 2, 3, 4, 10, 11, 12, 5}));
+      vec.push_front(vec.back());
+      EXPECT_EQ(vec.front().value, 5);
+      EXPECT_EQ(Tracked::alive, 13);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if TRIVIAL_FAST_PATHS
+  {
+    BEGIN_TEST(tm, "TrivialFastPaths", "vector<Point> grows, shifts and copies");
+
+    static_assert(sc::is_trivially_relocatable_v<Point>);
+    sc::vector<Point> vec;
+    for (int i{0}; i < 1000; ++i)
+      vec.push_back(Point{i, -i});
+    vec.push_front(Point{-1, 1});
+    vec.insert(vec.begin() + 500, {Point{7, 7}, Point{8, 8}});
+    vec.erase(vec.begin() + 10, vec.begin() + 20);
+    vec.pop_front();
+
+    EXPECT_EQ(vec.size(), 992u);
+    EXPECT_EQ(vec[0], (Point{0, 0}));
+    EXPECT_EQ(vec[8], (Point{8, -8}));
+    EXPECT_EQ(vec[9], (Point{19, -19}));
+    EXPECT_EQ(vec[488], (Point{498, -498}));
+    EXPECT_EQ(vec[489], (Point{7, 7}));
+    EXPECT_EQ(vec[490], (Point{8, 8}));
+    EXPECT_EQ(vec.back(), (Point{999, -999}));
+
+    sc::vector<Point> copy{vec};
+    EXPECT_EQ(copy, vec);
+    sc::vector<Point> assigned{Point{1, 1}};
+    assigned = vec;
+    EXPECT_EQ(assigned, vec);
+    assigned = sc::vector<Point>{Point{3, 3}, Point{4, 4}};
+    EXPECT_EQ(assigned.size(), 2u);
+    EXPECT_EQ(assigned[1], (Point{4, 4}));
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 992u);
+    EXPECT_EQ(vec, copy);
+  }
+#endif
+
+#if RELOCATABLE_OPT_IN
+  {
+    BEGIN_TEST(tm, "RelocatableOptIn", "is_trivially_relocatable<Handle>");
+
+    sc::vector<Handle> vec;
+    Handle::moves = 0;
+    vec.emplace(vec.begin(), -1);
+    for (int i{0}; i < 100; ++i)
+      vec.emplace_back(i);
+    vec.erase(vec.begin() + 1);
+    vec.pop_front();
+    vec.shrink_to_fit();
+    EXPECT_EQ(Handle::moves, 0);
+
+    EXPECT_EQ(vec.size(), 99u);
+    for (auto i{0u}; i < vec.size(); ++i)
+      EXPECT_EQ(*vec[i].value, (int)i + 1);
+  }
+#endif
+
+#if INSERT_ROLLBACK
+  {
+    BEGIN_TEST(tm, "InsertRollback", "insert(pos, first, last) whose 3rd copy throws");
+    Fragile::alive = 0;
+    {
+      const Fragile source[]{Fragile{10}, Fragile{11}, Fragile{12}};
+      // Gaps wider and narrower than the shifted tail.
+      for (std::size_t at : {1u, 3u}) {
+        sc::vector<Fragile> vec;
+        vec.reserve(16);
+        Fragile::copies_left = 4;
+        for (int i{0}; i < 4; ++i)
+          vec.push_back(Fragile{i});
+        Fragile::copies_left = 2;
+        bool thrown{false};
+        try {
+          vec.insert(vec.begin() + at, std::begin(source), std::end(source));
+        } catch (const std::runtime_error &) {
+          thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+        EXPECT_EQ(vec.size(), 4u);
+        for (int i{0}; i < 4; ++i)
+          EXPECT_EQ(vec[i].value, i);
+        EXPECT_EQ(Fragile::alive, 3 + 4);
+      }
+      EXPECT_EQ(Fragile::alive, 3);
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
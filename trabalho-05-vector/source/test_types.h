@@ -0,0 +1,83 @@
+#ifndef _TEST_TYPES_H_
+#define _TEST_TYPES_H_
+
+#include <memory>    // std::unique_ptr
+#include <stdexcept> // std::runtime_error
+
+#include "vector.h" // sc::is_trivially_relocatable
+
+/*!
+ * Element types shared by the container suites, which count what the
+ * containers do to their elements.
+ */
+namespace sc_test {
+
+/// Element type that keeps track of how many objects are alive.
+struct Tracked {
+  inline static int alive = 0;       //!< Objects currently alive.
+  inline static int constructed = 0; //!< Total of constructor calls.
+  int value;
+
+  Tracked() : value{0} { ++alive; ++constructed; }
+  Tracked(int v) : value{v} { ++alive; ++constructed; }
+  Tracked(const Tracked &other) : value{other.value} { ++alive; ++constructed; }
+  Tracked &operator=(const Tracked &other) = default;
+  ~Tracked() { --alive; }
+
+  bool operator==(const Tracked &rhs) const { return value == rhs.value; }
+  bool operator!=(const Tracked &rhs) const { return value != rhs.value; }
+  bool operator<(const Tracked &rhs) const { return value < rhs.value; }
+
+  static void reset() { alive = constructed = 0; }
+};
+
+/// Element type that counts how many times it is moved or copied.
+struct Moved {
+  inline static long transfers = 0; //!< Move and copy ctor/assignment calls.
+  inline static long alive = 0;     //!< Objects currently alive.
+  int value;
+
+  Moved(int v) : value{v} { ++alive; }
+  Moved(const Moved &other) : value{other.value} { ++transfers; ++alive; }
+  Moved(Moved &&other) noexcept : value{other.value} { ++transfers; ++alive; }
+  Moved &operator=(const Moved &other) { value = other.value; ++transfers; return *this; }
+  Moved &operator=(Moved &&other) noexcept { value = other.value; ++transfers; return *this; }
+  ~Moved() { --alive; }
+
+  bool operator==(const Moved &rhs) const { return value == rhs.value; }
+  bool operator!=(const Moved &rhs) const { return value != rhs.value; }
+};
+
+/// Element whose copy ctor throws once `copies_left` runs out. Its move may
+/// throw too (it never does), so relocating it goes through the copy.
+struct Fragile {
+  inline static int alive = 0;       //!< Objects currently alive.
+  inline static int copies_left = 0; //!< Copies allowed before one throws.
+  int value;
+
+  Fragile(int v) : value{v} { ++alive; }
+  Fragile(const Fragile &other) : value{other.value} {
+    if (copies_left-- == 0) { throw std::runtime_error("Fragile copy"); }
+    ++alive;
+  }
+  Fragile(Fragile &&other) noexcept(false) : value{other.value} { ++alive; }
+  Fragile &operator=(const Fragile &other) = default;
+  Fragile &operator=(Fragile &&other) = default;
+  ~Fragile() { --alive; }
+};
+
+/// Owns a heap value; relocatable, although not trivially copyable.
+struct Handle {
+  inline static int moves = 0; //!< Move ctor calls.
+  std::unique_ptr<int> value;
+
+  Handle(int v) : value{std::make_unique<int>(v)} {}
+  Handle(Handle &&other) noexcept : value{std::move(other.value)} { ++moves; }
+  Handle &operator=(Handle &&other) noexcept = default;
+};
+
+} // namespace sc_test.
+
+template <> struct sc::is_trivially_relocatable<sc_test::Handle> : std::true_type {};
+
+#endif
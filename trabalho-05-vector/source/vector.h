@@ -2,154 +2,164 @@
 #define _VECTOR_H_
 
 #include <algorithm>        // std::copy, std::equal, std::fill
+#include <bit>              // std::countr_zero
 #include <cassert>          // assert()
-#include <cstddef>          // std::size_t
+#include <compare>          // std::three_way_comparable, std::strong_ordering
+#include <concepts>         // std::convertible_to
+#include <cstddef>          // std::size_t, std::max_align_t
+#include <cstdlib>          // std::malloc, std::realloc, std::free
+#include <cstring>          // std::memcpy, std::memmove
 #include <exception>        // std::out_of_range
 #include <initializer_list> // std::initializer_list
 #include <iostream>         // std::cout, std::endl
 #include <iterator> // std::advance, std::begin(), std::end(), std::ostream_iterator
 #include <limits> // std::numeric_limits<T>
-#include <memory> // std::unique_ptr
+#include <memory> // std::allocator, std::allocator_traits
+#include <memory_resource> // std::pmr::polymorphic_allocator
+#include <new>    // std::bad_alloc, std::align_val_t, placement new
+#include <numeric> // std::lcm
+#include <type_traits> // std::is_nothrow_move_constructible
+#include <utility>     // std::move
+
+#if defined(__SSE2__)
+#include <emmintrin.h> // _mm_cmpeq_epi8, _mm_movemask_epi8
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h> // _mm256_cmpeq_epi8, _mm256_movemask_epi8
+#endif
+
+#include "bulk.h" // sc::bulk::copy, sc::bulk::fill
 
 /// Sequence container namespace.
 namespace sc {
 
-/// Implements tha infrastrcture to support a bidirectional iterator.
+/// Implements tha infrastrcture to support a contiguous iterator.
+/*!
+ * A thin wrapper around a raw pointer: every operation is O(1) and the type is
+ * trivially copyable, so it models `std::contiguous_iterator` and the
+ * standard algorithms may take their pointer (memmove, vectorized) paths.
+ */
 template <class T> class MyForwardIterator {
 public:
   using iterator = MyForwardIterator; //!< Alias to iterator.
   // Below we have the iterator_traits common interface
   using difference_type = std::ptrdiff_t; //!< Difference type to calculated
                                           //!< distance between iterators.
-  using value_type = T;              //!< Value type the iterator points to.
+  using value_type = std::remove_cv_t<T>; //!< Value type the iterator points to.
+  using element_type = T;            //!< Type of the pointed-to objects (const if read-only).
   using pointer = T *;               //!< Pointer to the value type.
   using reference = T &;             //!< Reference to the value type.
   using const_reference = const T &; //!< Reference to the value type.
   using iterator_category =
-      std::bidirectional_iterator_tag; //!< Iterator category.
+      std::random_access_iterator_tag; //!< Iterator category.
+  using iterator_concept =
+      std::contiguous_iterator_tag; //!< C++20 iterator concept.
 
   /*! Create an iterator around a raw pointer.
    * \param pt raw pointer to the container.
    */
-      MyForwardIterator(pointer pt = nullptr) : m_ptr(pt){};
-      MyForwardIterator(const iterator& other) {m_ptr = other.m_ptr;}
-      ~MyForwardIterator() = default;
-      // MyForwardIterator& operator=(const MyForwardIterator& rhs){
-      //   m_ptr = rhs.m_ptr;
-      //   return *this;
-      // }
+      constexpr MyForwardIterator(pointer pt = nullptr) : m_ptr(pt){};
+  /// Converts an iterator into a const_iterator.
+      template <class U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+      constexpr MyForwardIterator(const MyForwardIterator<U>& other) : m_ptr(other.m_ptr){}
 
   /// Access the content the iterator points to.
-      reference operator*() const {
+      constexpr reference operator*() const {
         assert(m_ptr != nullptr);
         return *m_ptr;
       }
 
   /// Overloaded `->` operator.
-      pointer operator->() const {
-        assert(m_ptr != nullptr);
+      constexpr pointer operator->() const {
         return m_ptr;
       }
 
-  /// Assignment operator.
-      iterator& operator=(const iterator& other){
-        m_ptr = other.m_ptr;
-        return *this;
+  /// Access the content `offset` positions away.
+      constexpr reference operator[](difference_type offset) const {
+        return m_ptr[offset];
       }
 
-  /// Copy constructor.
-      // MyForwardIterator<value_type>& operator=(const MyForwardIterator<value_type>& other){
-      //   m_ptr = other.m_ptr;
-      //   return *this;
-      // }
-
   /// Pre-increment operator.
-      iterator operator++() {
-        m_ptr++;
+      constexpr iterator &operator++() {
+        ++m_ptr;
         return *this;
       }
 
   /// Post-increment operator.
-      iterator operator++(int) {
+      constexpr iterator operator++(int) {
         iterator temp(*this);
-        m_ptr++;
+        ++m_ptr;
         return temp;
       }
 
   /// Pre-decrement operator.
-      iterator operator--() {
-        m_ptr--;
+      constexpr iterator &operator--() {
+        --m_ptr;
         return *this;
       }
 
   /// Post-decrement operator.
-      iterator operator--(int) {
+      constexpr iterator operator--(int) {
         iterator temp(*this);
-        m_ptr--;
+        --m_ptr;
         return temp;
       }
   /// Offset-adition operator.
-      iterator &operator+=(difference_type offset) {
-        while(offset != 0){
-          ++(*this);
-          --offset;
-        }
+      constexpr iterator &operator+=(difference_type offset) {
+        m_ptr += offset;
         return *this;
       }
   /// Offset-difference operator.
-      iterator &operator-=(difference_type offset) {
-        while(offset != 0){
-          --(*this);
-          --offset;
-        }
+      constexpr iterator &operator-=(difference_type offset) {
+        m_ptr -= offset;
         return *this;
       }
 
   /// LESS THAN operator.
-      friend bool operator<(const iterator &ita, const iterator &itb) {
+      friend constexpr bool operator<(const iterator &ita, const iterator &itb) {
         return ita.m_ptr < itb.m_ptr;
       }
 
   /// GREATER THAN operator.
-      friend bool operator>(const iterator &ita, const iterator &itb) {
+      friend constexpr bool operator>(const iterator &ita, const iterator &itb) {
         return ita.m_ptr > itb.m_ptr;
       }
   /// GREATER THAN OR EQUAL TO operator.
-      friend bool operator>=(const iterator &ita, const iterator &itb) {
+      friend constexpr bool operator>=(const iterator &ita, const iterator &itb) {
         return ita.m_ptr >= itb.m_ptr;
       }
   /// LESS THAN OR EQUAL TO operator.
-      friend bool operator<=(const iterator &ita, const iterator &itb) {
+      friend constexpr bool operator<=(const iterator &ita, const iterator &itb) {
         return ita.m_ptr <= itb.m_ptr;
       }
   /// Addition operator.
-      friend iterator operator+(difference_type offset, iterator it) {
+      friend constexpr iterator operator+(difference_type offset, iterator it) {
         return it + offset;
       }
   /// Addition operator.
-      friend iterator operator+(iterator it, difference_type offset) {
+      friend constexpr iterator operator+(iterator it, difference_type offset) {
         it += offset;
         return it;
       }
   /// Difference operator.
-      friend iterator operator-(iterator it, difference_type offset) {
+      friend constexpr iterator operator-(iterator it, difference_type offset) {
         it -= offset;
         return it;
       }
 
   /// Equality operator.
-      bool operator==(const iterator &rhs) const {
-        return rhs.m_ptr == m_ptr;
+      friend constexpr bool operator==(const iterator &ita, const iterator &itb) {
+        return ita.m_ptr == itb.m_ptr;
       }
 
   /// Not equality operator.
-      bool operator!=(const iterator &rhs) const {
-        return rhs.m_ptr != m_ptr;;
+      friend constexpr bool operator!=(const iterator &ita, const iterator &itb) {
+        return ita.m_ptr != itb.m_ptr;
       }
 
   /// Returns the difference between two iterators.
-      difference_type operator-(const iterator &rhs) const {
-        return m_ptr - rhs.m_ptr;
+      friend constexpr difference_type operator-(const iterator &ita, const iterator &itb) {
+        return ita.m_ptr - itb.m_ptr;
       }
 
   /// Stream extractor operator.
@@ -160,9 +170,661 @@ public:
       }
 
     private:
+  template <class> friend class MyForwardIterator;
   pointer m_ptr; //!< The raw pointer.
 };
 
+/// Tells whether objects of type T can be moved around with a plain memcpy.
+/*!
+ * A type is trivially relocatable when moving an object to a new address and
+ * ending the lifetime of the old one is equivalent to copying its bytes and
+ * forgetting about the source. Every trivially copyable type qualifies; other
+ * types (e.g. a class holding a `std::unique_ptr`) may opt in by specializing
+ * this trait:
+ *
+ *     template <> struct sc::is_trivially_relocatable<MyType> : std::true_type {};
+ *
+ * sc::vector then grows, shifts and erases such elements with
+ * `realloc`/`memmove` instead of calling their move constructors.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/// Helper variable template for sc::is_trivially_relocatable.
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/// Growth policies used by sc::vector to compute a new capacity.
+/*!
+ * A growth policy is any type that provides a static member function
+ *
+ *     static size_type next_capacity(size_type current, size_type required);
+ *
+ * which receives the current capacity and the minimum capacity the container
+ * needs, and returns the capacity to be allocated (never less than `required`).
+ * Geometric policies make a sequence of N appends cost amortized O(1) each.
+ */
+namespace growth {
+
+/// Doubles the capacity on every reallocation (default policy).
+struct doubling {
+  static constexpr std::size_t next_capacity(std::size_t current,
+                                             std::size_t required) {
+    return std::max(current * 2, required);
+  }
+};
+
+/// Grows the capacity by 50%, trading more reallocations for less slack.
+struct one_and_half {
+  static constexpr std::size_t next_capacity(std::size_t current,
+                                             std::size_t required) {
+    return std::max(current + current / 2, required);
+  }
+};
+
+/// Grows the capacity by a fixed number of elements (linear growth).
+template <std::size_t Step> struct fixed_step {
+  static_assert(Step > 0, "fixed_step growth requires a positive step");
+  static constexpr std::size_t next_capacity(std::size_t current,
+                                             std::size_t required) {
+    return std::max(current + Step, required);
+  }
+};
+
+} // namespace growth.
+
+/// Reclamation policies used by sc::vector to give released storage back.
+/*!
+ * A reclamation policy is any type that provides
+ *
+ *     static bool defer(std::size_t bytes);
+ *     template <typename Job> static void submit(Job &&job);
+ *
+ * Whenever a storage area of `bytes` bytes is released (destructor,
+ * assignment, reallocation), the vector asks defer(); if it says yes, the
+ * vector hands submit() a job that destroys the remaining elements and
+ * deallocates the area, to be run at any later time, on any thread.
+ * Otherwise it does that work right away. See sc::reclaim::background in
+ * reclaimer.h.
+ */
+namespace reclaim {
+
+/// Releases every storage area on the spot (default policy).
+struct immediate {
+  static constexpr bool defer(std::size_t) { return false; }
+  template <typename Job> static void submit(Job &&job) { job(); }
+};
+
+} // namespace reclaim.
+
+namespace detail {
+
+/// Detects an allocator extension `a.reallocate(p, old_n, new_n)`.
+template <typename Alloc, typename = void>
+struct has_reallocate : std::false_type {};
+
+template <typename Alloc>
+struct has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc &>().reallocate(
+                                 std::declval<typename std::allocator_traits<Alloc>::pointer>(),
+                                 std::size_t{}, std::size_t{}))>> : std::true_type {};
+
+/// Detects an allocator that customizes `construct`.
+template <typename Alloc, typename = void>
+struct has_construct : std::false_type {};
+
+template <typename Alloc>
+struct has_construct<Alloc, std::void_t<decltype(std::declval<Alloc &>().construct(
+                                std::declval<typename Alloc::value_type *>(),
+                                std::declval<const typename Alloc::value_type &>()))>>
+    : std::true_type {};
+
+/*!
+ * Tells whether constructing an element through the allocator is the same as
+ * placement new, so the container may copy and relocate bytes directly
+ * without skipping an allocator hook.
+ */
+template <typename Alloc>
+struct is_plain_construct_allocator
+    : std::bool_constant<!has_construct<Alloc>::value> {};
+
+template <typename U>
+struct is_plain_construct_allocator<std::allocator<U>> : std::true_type {};
+
+/// A polymorphic_allocator only adds work for types that take an allocator.
+template <typename U>
+struct is_plain_construct_allocator<std::pmr::polymorphic_allocator<U>>
+    : std::bool_constant<!std::uses_allocator_v<U, std::pmr::polymorphic_allocator<U>>> {};
+
+/*!
+ * Whether `It` may be walked more than once (a forward iterator or better),
+ * so a range can be measured with std::distance before it is copied.
+ */
+template <typename It>
+inline constexpr bool is_multipass_v = std::is_base_of_v<
+    std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+/// Number of slots every capacity is rounded up to (`Alloc::capacity_granule`, or 1).
+template <typename Alloc, typename = void>
+struct capacity_granule : std::integral_constant<std::size_t, 1> {};
+
+template <typename Alloc>
+struct capacity_granule<Alloc, std::void_t<decltype(Alloc::capacity_granule)>>
+    : std::integral_constant<std::size_t, Alloc::capacity_granule> {};
+
+/// Element types whose `==` means "same bytes", so memcmp() may compare them.
+/// Enumerations are left out: they may overload `==`.
+template <typename T>
+inline constexpr bool is_bitwise_comparable_v = std::is_integral_v<T> || std::is_pointer_v<T>;
+
+/// Element types compared by the vectorized kernels below.
+template <typename T>
+inline constexpr bool is_fast_comparable_v =
+    is_bitwise_comparable_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/*!
+ * Index of the first `i < n` with `!(a[i] == b[i])`, or `n` if there is none.
+ *
+ * With SSE2 (and AVX2, when the build enables it) whole blocks are compared
+ * at once and the mismatch is located from the compare mask, leaving a
+ * scalar loop for the last few elements. Floating point blocks use the
+ * ordered compare, so NaN never matches and -0.0 matches 0.0, as with `==`.
+ */
+template <typename T>
+std::size_t mismatch_index(const T *a, const T *b, std::size_t n) {
+  std::size_t i{0};
+#if defined(__SSE2__)
+  if constexpr (is_bitwise_comparable_v<T>) {
+    // The first differing byte belongs to the first differing element.
+    const auto *pa = reinterpret_cast<const unsigned char *>(a);
+    const auto *pb = reinterpret_cast<const unsigned char *>(b);
+    const std::size_t bytes = n * sizeof(T);
+    std::size_t off{0};
+#if defined(__AVX2__)
+    for (; off + 32 <= bytes; off += 32) {
+      const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pa + off));
+      const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pb + off));
+      const unsigned diff = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+      if (diff != 0) { return (off + std::countr_zero(diff)) / sizeof(T); }
+    }
+#endif
+    for (; off + 16 <= bytes; off += 16) {
+      const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pa + off));
+      const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pb + off));
+      const unsigned diff = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFFu;
+      if (diff != 0) { return (off + std::countr_zero(diff)) / sizeof(T); }
+    }
+    i = off / sizeof(T);
+  } else if constexpr (std::is_same_v<T, float>) {
+#if defined(__AVX2__)
+    for (; i + 8 <= n; i += 8) {
+      const __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_EQ_OQ);
+      const unsigned diff = ~static_cast<unsigned>(_mm256_movemask_ps(eq)) & 0xFFu;
+      if (diff != 0) { return i + std::countr_zero(diff); }
+    }
+#endif
+    for (; i + 4 <= n; i += 4) {
+      const __m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+      const unsigned diff = ~static_cast<unsigned>(_mm_movemask_ps(eq)) & 0xFu;
+      if (diff != 0) { return i + std::countr_zero(diff); }
+    }
+  } else if constexpr (std::is_same_v<T, double>) {
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+      const __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_EQ_OQ);
+      const unsigned diff = ~static_cast<unsigned>(_mm256_movemask_pd(eq)) & 0xFu;
+      if (diff != 0) { return i + std::countr_zero(diff); }
+    }
+#endif
+    for (; i + 2 <= n; i += 2) {
+      const __m128d eq = _mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+      const unsigned diff = ~static_cast<unsigned>(_mm_movemask_pd(eq)) & 0x3u;
+      if (diff != 0) { return i + std::countr_zero(diff); }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (!(a[i] == b[i])) { return i; }
+  }
+  return n;
+}
+
+/// Whether the `n` elements at `a` and `b` are all equal.
+template <typename T>
+bool equal_elements(const T *a, const T *b, std::size_t n) {
+  if constexpr (is_bitwise_comparable_v<T>) {
+    // The C library's memcmp() is already vectorized for the running CPU.
+    return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+  } else {
+    return mismatch_index(a, b, n) == n;
+  }
+}
+
+/// Element types that remove_value() compacts with SIMD compares.
+template <typename T>
+inline constexpr bool is_fast_removable_v = std::is_arithmetic_v<T> && is_fast_comparable_v<T>;
+
+/*!
+ * Moves the elements of `[data, data + n)` that are not equal to `value` to
+ * the front, keeping their order, and returns how many there are.
+ *
+ * With SSE2 the elements are compared 16 bytes at a time: a block without
+ * a match is stored whole at the output position, and only the blocks that
+ * hold a match are compacted element by element. Floating point blocks use
+ * the ordered compare, so NaN never matches and -0.0 matches 0.0, as with `==`.
+ */
+template <typename T>
+std::size_t remove_value(T *data, std::size_t n, T value) {
+  std::size_t out{0};
+  std::size_t i{0};
+#if defined(__SSE2__)
+  constexpr std::size_t lanes = 16 / sizeof(T);
+  T pattern[lanes];
+  for (auto &x : pattern)
+    x = value;
+  const __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern));
+  for (; i + lanes <= n; i += lanes) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    int hits;
+    if constexpr (std::is_same_v<T, float>) {
+      hits = _mm_movemask_ps(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      hits = _mm_movemask_pd(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+    } else if constexpr (sizeof(T) == 1) {
+      hits = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    } else if constexpr (sizeof(T) == 2) {
+      hits = _mm_movemask_epi8(_mm_cmpeq_epi16(block, needle));
+    } else if constexpr (sizeof(T) == 4) {
+      hits = _mm_movemask_epi8(_mm_cmpeq_epi32(block, needle));
+    } else {
+      // No 64-bit compare in SSE2: both 32-bit halves must match.
+      const __m128i eq = _mm_cmpeq_epi32(block, needle);
+      hits = _mm_movemask_epi8(_mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1))));
+    }
+    if (hits == 0) {
+      // `out <= i`, and the block is already loaded.
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(data + out), block);
+      out += lanes;
+      continue;
+    }
+    for (std::size_t j{0}; j < lanes; ++j) {
+      if (!(data[i + j] == value)) { data[out++] = data[i + j]; }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (!(data[i] == value)) { data[out++] = data[i]; }
+  }
+  return out;
+}
+
+/// Element types that either have `<=>` or can be ordered through `<`.
+template <typename T>
+concept synth_comparable = std::three_way_comparable<T> || requires(const T &a, const T &b) {
+  { a < b } -> std::convertible_to<bool>;
+};
+
+/// `a <=> b`, or a weak ordering built from `<` when T has no `<=>`.
+template <synth_comparable T>
+constexpr auto synth_three_way(const T &a, const T &b) {
+  if constexpr (std::three_way_comparable<T>) {
+    return a <=> b;
+  } else {
+    if (a < b) { return std::weak_ordering::less; }
+    if (b < a) { return std::weak_ordering::greater; }
+    return std::weak_ordering::equivalent;
+  }
+}
+
+template <typename T>
+using synth_three_way_result = decltype(synth_three_way(std::declval<const T &>(), std::declval<const T &>()));
+
+/*!
+ * Element policy of a container whose storage comes from `Alloc`.
+ *
+ * The element helpers below build and destroy elements through a policy like
+ * this one, so every container shifts and relocates its elements the same
+ * way. Besides `construct()` and `destroy()` a policy tells what may be done
+ * to the elements as raw bytes:
+ *  - `relocatable`: they may be moved around with memcpy/memmove;
+ *  - `bitwise_copyable`: copies of them may be written as raw bytes;
+ *  - `trivial_destroy`: destroying one is a no-op.
+ */
+template <typename Alloc>
+struct alloc_ops {
+  using traits = std::allocator_traits<Alloc>;
+  using value_type = typename traits::value_type;
+
+  static constexpr bool plain = is_plain_construct_allocator<Alloc>::value;
+  static constexpr bool relocatable = is_trivially_relocatable_v<value_type> && plain;
+  static constexpr bool bitwise_copyable = std::is_trivially_copyable_v<value_type> && plain;
+  static constexpr bool trivial_destroy = std::is_trivially_destructible_v<value_type> && plain;
+
+  Alloc &alloc; //!< The container's allocator.
+
+  template <typename... Args>
+  void construct(value_type *p, Args &&...args) const {
+    traits::construct(alloc, p, std::forward<Args>(args)...);
+  }
+
+  void destroy(value_type *p) const { traits::destroy(alloc, p); }
+};
+
+/// Element policy of a storage area that is not tied to an allocator.
+template <typename T>
+struct placement_ops {
+  using value_type = T;
+
+  static constexpr bool relocatable = is_trivially_relocatable_v<T>;
+  static constexpr bool bitwise_copyable = std::is_trivially_copyable_v<T>;
+  static constexpr bool trivial_destroy = std::is_trivially_destructible_v<T>;
+
+  template <typename... Args>
+  constexpr void construct(T *p, Args &&...args) const {
+    std::construct_at(p, std::forward<Args>(args)...);
+  }
+
+  constexpr void destroy(T *p) const { std::destroy_at(p); }
+};
+
+/// Whether the elements read from `It` may be memcpy'ed into storage of `Ops`.
+template <typename Ops, typename It>
+inline constexpr bool is_bitwise_copy_v =
+    Ops::bitwise_copyable && std::contiguous_iterator<It> &&
+    std::is_same_v<std::iter_value_t<It>, typename Ops::value_type>;
+
+/// Copies the bytes of `n` elements between possibly overlapping areas.
+template <typename T>
+void move_bytes(T *dest, const T *src, std::size_t n) {
+  if (n != 0) {
+    std::memmove(static_cast<void *>(dest), static_cast<const void *>(src), n * sizeof(T));
+  }
+}
+
+/// Destroys the elements in `[first, last)`.
+template <typename Ops, typename T>
+constexpr void destroy_range(const Ops &ops, T *first, T *last) {
+  if constexpr (!Ops::trivial_destroy) {
+    for (; first != last; ++first) { ops.destroy(first); }
+  }
+}
+
+/*!
+ * Constructs `n` elements read from `first` into the raw memory at `dest`.
+ * If a constructor throws, the elements already built are destroyed.
+ *
+ * The helpers working on raw bytes stay out of constant evaluation, so that
+ * a constexpr container (see sc::static_vector) may use them too.
+ */
+template <typename Ops, typename InputItr, typename T>
+constexpr void construct_copies(const Ops &ops, InputItr first, std::size_t n, T *dest) {
+  if constexpr (is_bitwise_copy_v<Ops, InputItr>) {
+    if (!std::is_constant_evaluated()) {
+      // `first` may not be dereferenced on an empty range.
+      if (n != 0) { bulk::copy(dest, std::to_address(first), n * sizeof(T)); }
+      return;
+    }
+  }
+  T *cur = dest;
+  try {
+    for (; n > 0; --n, ++first, ++cur) { ops.construct(cur, *first); }
+  } catch (...) {
+    destroy_range(ops, dest, cur);
+    throw;
+  }
+}
+
+/*!
+ * Constructs `n` elements from the same `args` into the raw memory at `dest`.
+ * With no arguments the elements are value-initialized. If a constructor
+ * throws, the elements already built are destroyed.
+ */
+template <typename Ops, typename T, typename... Args>
+constexpr void construct_n(const Ops &ops, T *dest, std::size_t n, const Args &...args) {
+  if constexpr (Ops::bitwise_copyable && sizeof...(Args) == 1 && (std::is_same_v<Args, T> && ...)) {
+    if (!std::is_constant_evaluated()) {
+      bulk::fill(dest, n, args...);
+      return;
+    }
+  } else if constexpr (Ops::bitwise_copyable && sizeof...(Args) == 0 &&
+                       std::is_trivially_default_constructible_v<T>) {
+    if (!std::is_constant_evaluated()) {
+      bulk::fill(dest, n, T{}); // Value-initialized: all zeros.
+      return;
+    }
+  }
+  T *cur = dest;
+  try {
+    for (; n > 0; --n, ++cur) { ops.construct(cur, args...); }
+  } catch (...) {
+    destroy_range(ops, dest, cur);
+    throw;
+  }
+}
+
+/*!
+ * Builds the elements of `[first, last)` in the raw memory at `dest`, in
+ * another area.
+ *
+ * Relocatable elements are copied as bytes, after which the sources hold no
+ * live object. Other elements are moved when their move constructor cannot
+ * throw (or when they cannot be copied at all), otherwise they are copied
+ * (`std::move_if_noexcept`); the sources stay alive for the caller to destroy
+ * with release_transferred() once the whole transfer made it, so a throw
+ * leaves them as they were.
+ */
+template <typename Ops, typename T>
+constexpr void transfer(const Ops &ops, T *first, T *last, T *dest) {
+  if constexpr (Ops::relocatable) {
+    if (!std::is_constant_evaluated()) {
+      if (first != last) {
+        bulk::copy(static_cast<void *>(dest), static_cast<const void *>(first),
+                   (last - first) * sizeof(T));
+      }
+      return;
+    }
+  }
+  T *cur = dest;
+  try {
+    for (T *src = first; src != last; ++src, ++cur) {
+      ops.construct(cur, std::move_if_noexcept(*src));
+    }
+  } catch (...) {
+    destroy_range(ops, dest, cur);
+    throw;
+  }
+}
+
+/// Destroys the sources of a completed transfer().
+template <typename Ops, typename T>
+constexpr void release_transferred(const Ops &ops, T *first, T *last) {
+  if constexpr (!Ops::relocatable) { destroy_range(ops, first, last); }
+}
+
+/// Transfers `[first, last)` to the raw memory at `dest`, leaving the sources raw.
+template <typename Ops, typename T>
+constexpr void relocate(const Ops &ops, T *first, T *last, T *dest) {
+  transfer(ops, first, last, dest);
+  release_transferred(ops, first, last);
+}
+
+/*!
+ * transfer()s the `size` elements at `first` to `dest`, leaving `n` raw slots
+ * right before element `idx`. If it throws, whatever was built at `dest` is
+ * destroyed again.
+ */
+template <typename Ops, typename T>
+constexpr void transfer_around(const Ops &ops, T *first, std::size_t size, std::size_t idx,
+                               std::size_t n, T *dest) {
+  transfer(ops, first, first + idx, dest);
+  try {
+    transfer(ops, first + idx, first + size, dest + idx + n);
+  } catch (...) {
+    destroy_range(ops, dest, dest + idx);
+    throw;
+  }
+}
+
+/*!
+ * Shifts the elements in `[idx, size)` of `data` `n` slots to the right.
+ *
+ * On return the slots `[idx, idx + n)` hold no live object, so the caller must
+ * construct elements there (or undo it with close_gap()). The storage must
+ * have room for `size + n` elements.
+ */
+template <typename Ops, typename T>
+constexpr void open_gap(const Ops &ops, T *data, std::size_t size, std::size_t idx, std::size_t n) {
+  const std::size_t tail = size - idx;
+  if (tail == 0 || n == 0) { return; }
+  if constexpr (Ops::relocatable) {
+    if (!std::is_constant_evaluated()) {
+      move_bytes(data + idx + n, data + idx, tail);
+      return;
+    }
+  }
+  // The last `min(n, tail)` elements land on raw memory past the end.
+  const std::size_t to_raw = std::min(n, tail);
+  construct_copies(ops, std::make_move_iterator(data + size - to_raw), to_raw,
+                   data + size + n - to_raw);
+  // The remaining ones land on live (already shifted) elements.
+  std::move_backward(data + idx, data + size - to_raw, data + size + n - to_raw);
+  // Whatever is left inside the gap is destroyed, making it raw memory again.
+  destroy_range(ops, data + idx, data + idx + to_raw);
+}
+
+/*!
+ * Undoes open_gap(ops, data, size, idx, n) when the gap could not be filled.
+ *
+ * The gap `[idx, idx + n)` must hold no live object. The elements in
+ * `[idx + n, size + n)` are shifted back to `idx`, so that `[0, size)` holds
+ * live elements again and nothing lives past it.
+ */
+template <typename Ops, typename T>
+constexpr void close_gap(const Ops &ops, T *data, std::size_t size, std::size_t idx, std::size_t n) {
+  const std::size_t tail = size - idx;
+  if (tail == 0 || n == 0) { return; }
+  if constexpr (Ops::relocatable) {
+    if (!std::is_constant_evaluated()) {
+      move_bytes(data + idx, data + idx + n, tail);
+      return;
+    }
+  }
+  // The first `min(n, tail)` elements land on the raw gap.
+  const std::size_t to_raw = std::min(n, tail);
+  for (std::size_t i = 0; i < to_raw; ++i) {
+    ops.construct(data + idx + i, std::move(data[idx + n + i]));
+  }
+  // The remaining ones land on live (already shifted back) elements.
+  std::move(data + idx + n + to_raw, data + size + n, data + idx + to_raw);
+  // Past the end, only the slots that were not part of the gap are live.
+  destroy_range(ops, data + std::max(size, idx + n), data + size + n);
+}
+
+/*!
+ * Replaces the `size` live elements at `data` with `n` elements read from
+ * `first`; the storage must have room for them.
+ *
+ * Live elements are reused through assignment; only the difference in size
+ * is constructed or destroyed.
+ */
+template <typename Ops, typename T, typename InputItr>
+constexpr void assign_n(const Ops &ops, T *data, std::size_t size, InputItr first, std::size_t n) {
+  if constexpr (is_bitwise_copy_v<Ops, InputItr>) {
+    if (!std::is_constant_evaluated()) {
+      // Nothing to construct or destroy: just overwrite the bytes.
+      construct_copies(ops, first, n, data);
+      return;
+    }
+  }
+  if (n <= size) {
+    std::copy_n(first, n, data);
+    destroy_range(ops, data + n, data + size);
+  } else {
+    auto mid = std::next(first, size);
+    std::copy(first, mid, data);
+    construct_copies(ops, mid, n - size, data + size);
+  }
+}
+
+} // namespace detail.
+
+/// Allocator that takes its memory from `std::malloc`.
+/*!
+ * Besides the standard allocator interface it offers `reallocate()`, which
+ * sc::vector uses to grow buffers of trivially relocatable elements through
+ * `std::realloc`. The block may then be extended in place or, for large
+ * blocks, have its pages remapped, instead of being copied.
+ */
+template <typename T> struct malloc_allocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "malloc_allocator does not support over-aligned types");
+  using value_type = T;
+
+  malloc_allocator() noexcept = default;
+  template <typename U> malloc_allocator(const malloc_allocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    void *raw = std::malloc(n * sizeof(T));
+    if (raw == nullptr) { throw std::bad_alloc(); }
+    return static_cast<T *>(raw);
+  }
+
+  void deallocate(T *p, std::size_t) noexcept { std::free(p); }
+
+  /// Resizes the block at `p` (holding `old_n` slots) to `new_n` slots.
+  T *reallocate(T *p, std::size_t /* old_n */, std::size_t new_n) {
+    void *raw = std::realloc(static_cast<void *>(p), new_n * sizeof(T));
+    if (raw == nullptr) { throw std::bad_alloc(); }
+    return static_cast<T *>(raw);
+  }
+
+  friend bool operator==(const malloc_allocator &, const malloc_allocator &) { return true; }
+  friend bool operator!=(const malloc_allocator &, const malloc_allocator &) { return false; }
+};
+
+/// Allocator whose blocks start at an `Align`-byte boundary.
+/*!
+ * Use it to feed SIMD kernels aligned loads (`Align` = 32 or 64) or to give a
+ * buffer whole cache lines or pages of its own. Since the alignment is part
+ * of the type, it is kept by reserve(), shrink_to_fit() and copies alike.
+ *
+ * With `PadCapacity`, the allocator also publishes a `capacity_granule` and
+ * sc::vector rounds every capacity up to whole `Align`-byte blocks, so a
+ * kernel may process `[data(), data() + capacity())` in full vector steps
+ * without a scalar tail loop.
+ */
+template <typename T, std::size_t Align = 64, bool PadCapacity = false>
+struct aligned_allocator {
+  static_assert(Align != 0 && (Align & (Align - 1)) == 0,
+                "aligned_allocator requires a power of two alignment");
+  using value_type = T;
+
+  /// Alignment of every block handed out.
+  static constexpr std::size_t alignment = std::max(Align, alignof(T));
+  /// Capacities are kept a multiple of this many elements.
+  static constexpr std::size_t capacity_granule =
+      PadCapacity ? std::lcm(Align, sizeof(T)) / sizeof(T) : 1;
+
+  template <typename U> struct rebind { using other = aligned_allocator<U, Align, PadCapacity>; };
+
+  aligned_allocator() noexcept = default;
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Align, PadCapacity> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    ::operator delete(p, n * sizeof(T), std::align_val_t{alignment});
+  }
+
+  friend bool operator==(const aligned_allocator &, const aligned_allocator &) { return true; }
+  friend bool operator!=(const aligned_allocator &, const aligned_allocator &) { return false; }
+};
+
 /// This class implements the ADT list with dynamic array.
 /*!
  * sc::vector is a sequence container that encapsulates dynamic m_end_type arrays.
@@ -173,19 +835,42 @@ public:
  * This means that a pointer to an element of a vector may be passed to
  * any function that expects a pointer to an element of an array.
  *
+ * The storage area is raw (uninitialized) memory obtained from the
+ * allocator: only the slots in `[0, size())` hold live objects, which are
+ * created and destroyed through `std::allocator_traits`. Reserving capacity
+ * never constructs any element.
+ *
  * \tparam T The type of the elements.
+ * \tparam Allocator The allocator used to acquire the storage area.
+ * \tparam GrowthPolicy How the capacity grows when the vector runs out of
+ *         room (see sc::growth).
+ * \tparam ReclaimPolicy When released storage areas are destroyed and
+ *         deallocated (see sc::reclaim).
  */
-template <typename T> class vector {
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = growth::doubling,
+          typename ReclaimPolicy = reclaim::immediate>
+class vector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Allocator::value_type must be the same as T");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T *>,
+                "sc::vector requires an allocator with raw pointers");
+
   //=== Aliases
 public:
   using difference_type = std::ptrdiff_t;
   using size_type = unsigned long; //!< The m_end_type type.
   using value_type = T;            //!< The value type.
   using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using const_pointer = const value_type *; //!< Pointer to a const value.
   using reference =
       value_type &; //!< Reference to a value stored in the container.
   using const_reference = const value_type &; //!< Const reference to a value
                                               //!< stored in the container.
+  using allocator_type = Allocator;   //!< The allocator type.
+  using growth_policy = GrowthPolicy; //!< The capacity growth policy.
+  using reclaim_policy = ReclaimPolicy; //!< The storage reclamation policy.
 
   using iterator =
       MyForwardIterator<value_type>; //!< The iterator, instantiated from a
@@ -197,86 +882,195 @@ public:
 
   //=== [I] SPECIAL MEMBERS (6 OF THEM)
 /**
- * @brief Constructs a vector with a given capacity.
+ * @brief Constructs an empty vector, without allocating any memory.
+ */
+vector() : vector(Allocator()) {}
+
+/**
+ * @brief Constructs an empty vector that will allocate from `alloc`.
  * 
- * @param cp The initial capacity of the vector.
+ * @param alloc The allocator to use.
  */
-        explicit vector(size_type cp = 0) {
-        m_storage = new T[cp];
-        m_capacity = cp;
-    m_end = cp; // Array começa vazio.
-    for (size_type i{0}; i < m_end; ++i) {
-      m_storage[i] = T();
-    }
-  }
+explicit vector(const Allocator &alloc) noexcept
+  : m_end{0}, m_capacity{0}, m_storage{nullptr}, m_alloc{alloc} {}
+
+/**
+ * @brief Constructs a vector with `cp` value-initialized elements.
+ * 
+ * @param cp The initial size (and capacity) of the vector.
+ * @param alloc The allocator to use.
+ */
+explicit vector(size_type cp, const Allocator &alloc = Allocator())
+  : vector(alloc) {
+  init_storage(cp);
+  construct_n(m_storage, cp);
+  m_end = cp;
+}
 
 /**
  * @brief Destructor for the vector.
  */
-  virtual ~vector() { delete[] m_storage; }
+  virtual ~vector() { release(m_storage, m_end, m_capacity); }
 
 /**
  * @brief Copy constructor.
  * 
+ * The allocator is obtained with `select_on_container_copy_construction`.
+ * 
  * @param other The vector to copy from.
  */
-   vector(const vector &other){
-   m_capacity = other.m_capacity;
-   m_end = other.m_end;
-   m_storage = new T[m_capacity];
-   std::copy(other.m_storage, other.m_storage + m_end, m_storage);
- }
+vector(const vector &other)
+  : vector(other, alloc_traits::select_on_container_copy_construction(other.m_alloc)) {}
 
 /**
- * @brief Constructs a vector with elements from an initializer list.
+ * @brief Copy constructor with a given allocator.
  * 
- * @param il The initializer list containing elements to initialize the vector.
+ * @param other The vector to copy from.
+ * @param alloc The allocator to use.
  */
-  vector(const std::initializer_list<T> &il) {
-    m_capacity = il.size();
-    m_storage = new T[m_capacity];
-    m_end = m_capacity; 
-    std::copy(il.begin(), il.end(), m_storage);
+vector(const vector &other, const Allocator &alloc)
+  : vector(alloc) {
+  init_storage(other.m_capacity);
+  construct_copies(other.m_storage, other.m_end, m_storage);
+  m_end = other.m_end;
 }
 
+/**
+ * @brief Move constructor.
+ * 
+ * Takes over the storage (and the allocator) of `other` in O(1), leaving it empty.
+ * 
+ * @param other The vector to move from.
+ */
+vector(vector &&other) noexcept
+  : m_end{other.m_end}, m_capacity{other.m_capacity}, m_storage{other.m_storage},
+    m_alloc{std::move(other.m_alloc)} {
+  other.m_end = 0;
+  other.m_capacity = 0;
+  other.m_storage = nullptr;
+}
 
+/**
+ * @brief Move constructor with a given allocator.
+ * 
+ * The storage is taken over only when `alloc` can release it; otherwise the
+ * elements are moved one by one into memory obtained from `alloc`.
+ * 
+ * @param other The vector to move from.
+ * @param alloc The allocator to use.
+ */
+vector(vector &&other, const Allocator &alloc)
+  : vector(alloc) {
+  if (m_alloc == other.m_alloc) {
+    steal(other);
+  } else {
+    init_storage(other.m_end);
+    construct_copies(std::make_move_iterator(other.m_storage), other.m_end, m_storage);
+    m_end = other.m_end;
+    other.clear();
+  }
+}
+
+/**
+ * @brief Constructs a vector with elements from an initializer list.
+ * 
+ * @param il The initializer list containing elements to initialize the vector.
+ * @param alloc The allocator to use.
+ */
+vector(const std::initializer_list<T> &il, const Allocator &alloc = Allocator())
+  : vector(il.begin(), il.end(), alloc) {}
 
 /**
  * @brief Constructs a vector from a range of elements defined by iterators.
  * 
+ * A forward (or better) range is measured first and copied into a single
+ * allocation. A single-pass range, e.g. a std::istream_iterator, is read in
+ * one pass, growing as by push_back().
+ * 
  * @tparam InputIterator Type of the input iterators.
  * @param first Iterator to the beginning of the range.
  * @param last Iterator to the end of the range.
+ * @param alloc The allocator to use.
  */
-template <typename InputItr> vector(InputItr first, InputItr last){
-  difference_type pointersRange = std::distance(first, last);
-  m_storage = new value_type[pointersRange];
-  std::copy(first, last, m_storage);
-  m_end = pointersRange;
-  m_capacity = pointersRange;
+template <typename InputItr>
+vector(InputItr first, InputItr last, const Allocator &alloc = Allocator())
+  : vector(alloc) {
+  if constexpr (detail::is_multipass_v<InputItr>) {
+    size_type pointersRange = std::distance(first, last);
+    init_storage(pointersRange);
+    construct_copies(first, pointersRange, m_storage);
+    m_end = pointersRange;
+  } else {
+    for (; first != last; ++first){ emplace_back(*first); }
+  }
 }
 
 /**
  * @brief Copy assignment operator.
  * 
+ * The allocator of `rhs` is adopted when the allocator type asks for it
+ * (`propagate_on_container_copy_assignment`).
+ * 
  * @param rhs The vector to copy from.
  * @return Reference to the modified vector.
  */
 vector &operator=(const vector &rhs) {
-  if (capacity() < rhs.m_end) {
-    reserve(rhs.m_end);
+  if (this == &rhs) { return *this; }
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+    if (m_alloc != rhs.m_alloc) {
+      // Our storage cannot be released by the incoming allocator.
+      release(m_storage, m_end, m_capacity);
+      m_storage = nullptr;
+      m_end = m_capacity = 0;
+    }
+    m_alloc = rhs.m_alloc;
   }
-  m_end = rhs.m_end;
-  std::copy(rhs.cbegin(), rhs.cend(), begin());
+  assign_n(rhs.m_storage, rhs.m_end);
   return *this; 
 }
 
 
+/**
+ * @brief Move assignment operator.
+ * 
+ * Releases the current elements and takes over the storage of `rhs` in O(1),
+ * leaving it empty. When the allocators do not propagate and are not equal,
+ * the elements are moved one by one instead.
+ * 
+ * @param rhs The vector to move from.
+ * @return Reference to the modified vector.
+ */
+vector &operator=(vector &&rhs) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value) {
+  if (this == &rhs) { return *this; }
+  if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+    release(m_storage, m_end, m_capacity);
+    m_alloc = std::move(rhs.m_alloc);
+    steal(rhs);
+  } else {
+    if (m_alloc == rhs.m_alloc) {
+      release(m_storage, m_end, m_capacity);
+      steal(rhs);
+    } else {
+      assign_n(std::make_move_iterator(rhs.m_storage), rhs.m_end);
+      rhs.clear();
+    }
+  }
+  return *this;
+}
+
+/// Returns a copy of the allocator associated with the vector.
+allocator_type get_allocator() const { return m_alloc; }
+
+
   //=== [II] ITERATORS
-iterator begin() { return iterator{&m_storage[0]}; }
-iterator end() {return iterator(&m_storage[m_end]); }
-const_iterator cbegin() const { return const_iterator(&m_storage[0]); }
-const_iterator cend() const { return const_iterator(&m_storage[m_end]); }
+iterator begin() { return iterator{m_storage}; }
+iterator end() {return iterator(m_storage + m_end); }
+const_iterator begin() const { return const_iterator(m_storage); }
+const_iterator end() const { return const_iterator(m_storage + m_end); }
+const_iterator cbegin() const { return const_iterator(m_storage); }
+const_iterator cend() const { return const_iterator(m_storage + m_end); }
 
   // [III] Capacity
 [[nodiscard]] bool full() const { return m_end == m_capacity; }
@@ -286,6 +1080,7 @@ const_iterator cend() const { return const_iterator(&m_storage[m_end]); }
 
   // [IV] Modifiers
 void clear(){
+  destroy(m_storage, m_storage + m_end);
   m_end = 0;
 }
 
@@ -295,10 +1090,16 @@ void clear(){
  * @param value The value to be inserted.
  */
 void push_front(const_reference value){
-  if (full()){ reserve(m_capacity*2); }
-  std::move_backward(m_storage, m_storage + m_end, m_storage+1);
-  m_storage[0] = value;
-  m_end++;
+  emplace(begin(), value);
+}
+
+/**
+ * @brief Inserts an element at the beginning of the vector, moving it in.
+ * 
+ * @param value The value to be inserted.
+ */
+void push_front(value_type &&value){
+  emplace(begin(), std::move(value));
 }
 
 /**
@@ -307,8 +1108,66 @@ void push_front(const_reference value){
  * @param value The value to be inserted.
  */
 void push_back(const_reference value){
-  if (full()){ reserve(capacity()+1); }
-  m_storage[m_end++] = value;
+  emplace_back(value);
+}
+
+/**
+ * @brief Inserts an element at the end of the vector, moving it in.
+ * 
+ * @param value The value to be inserted.
+ */
+void push_back(value_type &&value){
+  emplace_back(std::move(value));
+}
+
+/**
+ * @brief Constructs an element in place at the end of the vector.
+ * 
+ * The arguments are forwarded to the element's constructor, so no temporary
+ * is created and no copy is made.
+ * 
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ */
+template <typename... Args>
+reference emplace_back(Args &&...args){
+  if (full()){
+    realloc_emplace(m_end, std::forward<Args>(args)...);
+  } else {
+    construct_at(m_storage + m_end, std::forward<Args>(args)...);
+    ++m_end;
+  }
+  return m_storage[m_end - 1];
+}
+
+/**
+ * @brief Constructs an element in place right before `pos`.
+ * 
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return An iterator pointing to the new element.
+ */
+template <typename... Args>
+iterator emplace(const_iterator pos, Args &&...args){
+  const size_type idx = pos - cbegin();
+  if (full()){
+    realloc_emplace(idx, std::forward<Args>(args)...);
+  } else if (idx == m_end){
+    construct_at(m_storage + m_end, std::forward<Args>(args)...);
+    ++m_end;
+  } else {
+    // The arguments may refer to an element that is about to be shifted.
+    value_type tmp(std::forward<Args>(args)...);
+    open_gap(idx, 1);
+    try {
+      construct_at(m_storage + idx, std::move(tmp));
+    } catch (...) {
+      close_gap(idx, 1);
+      throw;
+    }
+    ++m_end;
+  }
+  return begin() + idx;
 }
 
 /**
@@ -318,8 +1177,7 @@ void push_back(const_reference value){
  */
 void pop_back(){
   if(empty()){throw std::length_error("POP_BACK(EMPTY)\n");}
-  m_storage[m_end-1] = value_type(); 
-  m_end--;
+  destroy_at(m_storage + --m_end);
 }
 
 /**
@@ -329,15 +1187,20 @@ void pop_back(){
  */
 void pop_front(){
   if(empty()){throw std::length_error("POP_FRONT(EMPTY)\n");}
-  std::copy(m_storage+1, m_storage + m_end, m_storage);
-  m_storage[m_end-1] = value_type();
-  --m_end;
+  if constexpr (relocatable) {
+    destroy_at(m_storage);
+    detail::move_bytes(m_storage, m_storage + 1, --m_end);
+  } else {
+    std::move(m_storage+1, m_storage + m_end, m_storage);
+    destroy_at(m_storage + --m_end);
+  }
 }
 
 /**
  * @brief Inserts a range of elements into the vector at a specified position.
  * 
  * Inserts elements from the range [first, last) into the vector at the position indicated by pos.
+ * A single-pass range (e.g. a std::istream_iterator) is read only once.
  * 
  * @tparam InputItr Type of the input iterators.
  * @param pos Iterator indicating the position where the elements will be inserted.
@@ -347,23 +1210,27 @@ void pop_front(){
  */
 template<typename InputItr>
 iterator insert (iterator pos, InputItr first, InputItr last) {
-  const auto pointersRange = std::distance (first, last);
-  if (pointersRange == 0) { return pos; }
-
-  const auto pointerToNewElementsAdding = std::distance (begin(), pos);
-  //ao que parece, esse calculo é necessário para conseguirmos usar essa pos dnv
+  // Iterators are invalidated by a reallocation, so we keep the index instead.
+  const size_type idx = pos - begin();
+  if constexpr (!detail::is_multipass_v<InputItr>) {
+    return insert_single_pass(idx, first, last);
+  } else {
+    const size_type pointersRange = std::distance (first, last);
+    if (pointersRange == 0) { return pos; }
+
+    grow_for(size() + pointersRange);
+    open_gap(idx, pointersRange);
+    try {
+      construct_copies(first, pointersRange, m_storage + idx);
+    } catch (...) {
+      // construct_copies() left the gap raw again; shift the tail back over it.
+      close_gap(idx, pointersRange);
+      throw;
+    }
+    m_end += pointersRange;
 
-  //reescrevendo o m_storage+m_end com os ponteiros dispomniveis arghhh
-  if (size() + pointersRange > capacity()){ 
-  	reserve (size() + pointersRange); 
+    return begin() + idx;
   }
-  
-  pos = begin() + pointerToNewElementsAdding;
-  std::copy_backward (pos, end (), end() + pointersRange);
-  std::copy (first, last, pos);
-  m_end += pointersRange;
-
-  return pos;
 }
 
 /**
@@ -379,8 +1246,7 @@ iterator insert (iterator pos, InputItr first, InputItr last) {
  */
 template<typename InputItr>
 iterator insert(const_iterator pos, InputItr first, InputItr last){
-  iterator init{pos};
-  return insert(init, first, last);
+  return insert(begin() + (pos - cbegin()), first, last);
 }
 
 /**
@@ -418,52 +1284,211 @@ iterator insert(const_iterator pos, const std::initializer_list<value_type>&ilis
  * @param value The value to be inserted.
  * @return An iterator pointing to the inserted element.
  */
-iterator insert(iterator pos, const_reference value) { return insert(pos, {value}); }
+iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
 
 /**
- * @brief Inserts a single element into the vector at a specified position.
- * 
- * Inserts the element value into the vector at the position indicated by pos.
+ * @brief Inserts a single element into the vector at a specified position, moving it in.
  * 
  * @param pos Iterator indicating the position where the element will be inserted.
  * @param value The value to be inserted.
  * @return An iterator pointing to the inserted element.
  */
-iterator insert(const_iterator pos, const_reference value) { return insert(pos, value); }
+iterator insert(const_iterator pos, value_type &&value) { return emplace(pos, std::move(value)); }
+
+/**
+ * @brief Inserts a batch of values at several positions in a single pass.
+ * 
+ * `values[j]` is inserted before the element at index `positions[j]` of the
+ * vector as it was before the call (an index equal to size() appends), and
+ * values with the same position keep their order. The capacity grows at most
+ * once, then the elements are merged in from the back, so each of them is
+ * moved once: O(size() + k), where k separate insert() calls would be
+ * O(size() * k).
+ * 
+ * @param first Iterator to the beginning of the positions, sorted in non-descending order.
+ * @param last Iterator to the end of the positions.
+ * @param values Iterator to the first of the k values; they must not refer to elements of this vector.
+ * @throws std::out_of_range if the positions are not sorted or are past size();
+ *         the vector is left untouched.
+ * 
+ * If copying a value throws, trivially relocatable elements are compacted
+ * back together: the vector keeps all its elements and the values inserted
+ * so far. Otherwise only the basic guarantee holds: the vector keeps size(),
+ * but the elements already moved up are destroyed and some of the others
+ * may be left moved-from.
+ */
+template <typename PosItr, typename ValItr>
+void insert_batch(PosItr first, PosItr last, ValItr values){
+  size_type k{0};
+  size_type prev{0};
+  for (PosItr it = first; it != last; ++it, ++k){
+    const size_type at = *it;
+    if (at > m_end || at < prev){ throw std::out_of_range("Invalid positions provided."); }
+    prev = at;
+  }
+  if (k == 0){ return; }
+  grow_for(m_end + k);
+
+  const size_type old_end = m_end;
+  size_type src = old_end;  // Elements in [0, src) have not been moved yet.
+  size_type dst = old_end + k; // Slots in [dst, old_end + k) are final.
+  size_type built = old_end + k; // Slots in [built, old_end + k) hold final elements.
+  ValItr value = std::next(values, k);
+  try {
+    while (last != first){
+      --last;
+      --value;
+      const size_type at = *last;
+      const size_type run = src - at;
+      dst -= run;
+      if constexpr (relocatable) {
+        detail::move_bytes(m_storage + dst, m_storage + at, run);
+        src = at;
+        built = dst;
+        construct_at(m_storage + dst - 1, *value);
+      } else {
+        // Slots past the old end are raw memory; the ones below hold live
+        // (possibly moved-from) elements.
+        for (size_type i = run; i-- > 0;){
+          place(dst + i, old_end, std::move(m_storage[at + i]));
+          built = dst + i;
+        }
+        place(dst - 1, old_end, *value);
+        src = at;
+      }
+      built = --dst;
+    }
+  } catch (...) {
+    if constexpr (relocatable) {
+      // [0, src) and [built, old_end + k) hold every element: close the hole.
+      detail::move_bytes(m_storage + src, m_storage + built, old_end + k - built);
+      m_end = src + (old_end + k - built);
+    } else {
+      // [0, old_end) stays live; whatever was built past it goes.
+      destroy(m_storage + std::max(built, old_end), m_storage + old_end + k);
+    }
+    throw;
+  }
+  m_end = old_end + k;
+}
 
 
 /**
  * @brief Increases the capacity of the vector to at least new_cap.
  * 
  * If new_cap is greater than the current capacity(), new storage is allocated with at least
- * new_cap size. All elements are copied to the new storage, and the old storage is deallocated.
+ * new_cap size. All elements are moved to the new storage (copied, if moving could throw),
+ * and the old storage is deallocated.
+ * No element is constructed in the extra capacity.
  * 
  * @param new_cap The new capacity of the vector.
  */
 void reserve(size_type new_cap){
-  if(new_cap == 0 || new_cap <= m_capacity){return;}
-  value_type* new_storage = new value_type[new_cap];
-
-  std::copy(m_storage, m_storage+m_end, new_storage);
-  delete[] m_storage;
-
-  m_storage = new_storage;
-  m_capacity = new_cap;
+  if(new_cap <= m_capacity){return;}
+  reallocate(new_cap);
 }
 
 /**
  * @brief Reduces the capacity of the vector to fit its size.
  * 
- * If the vector is not empty, allocates a new storage with size equal to the current size()
- * and copies all elements to the new storage. Then deallocates the old storage.
+ * Allocates a new storage with size equal to the current size() and moves
+ * all elements to the new storage. Then deallocates the old storage.
  */
 void shrink_to_fit(){
-  if(empty()){return;}
-  value_type* new_storage = new value_type[m_end];
-  std::copy(m_storage, m_storage+m_end, new_storage);
-  delete[] m_storage;
-  m_storage = new_storage;
-  m_capacity = m_end;
+  if(padded(m_end) == m_capacity){return;}
+  reallocate(m_end);
+}
+
+/**
+ * @brief Changes the number of elements to `count`.
+ * 
+ * Extra elements are destroyed; missing ones are value-initialized (zeroed,
+ * for arithmetic types) at the end.
+ * 
+ * @param count The new size of the vector.
+ */
+void resize(size_type count){
+  if (count <= m_end){
+    truncate(count);
+    return;
+  }
+  grow_for(count);
+  construct_n(m_storage + m_end, count - m_end);
+  m_end = count;
+}
+
+/**
+ * @brief Changes the number of elements to `count`, appending copies of `value`.
+ * 
+ * @param count The new size of the vector.
+ * @param value The value of the appended elements.
+ */
+void resize(size_type count, const_reference value){
+  if (count <= m_end){
+    truncate(count);
+    return;
+  }
+  append(count - m_end, value);
+}
+
+/**
+ * @brief Changes the number of elements to `count`, default-initializing new ones.
+ * 
+ * Elements of trivially default constructible types (e.g. `char`, `int` or
+ * a POD struct) are left uninitialized, so the caller can fill them in
+ * directly, without paying for a zero-fill first:
+ * \code
+ * buf.resize_for_overwrite(4096);
+ * const ssize_t n = ::read(fd, buf.data(), buf.size());
+ * if (n < 0) { throw std::system_error(errno, std::generic_category()); }
+ * buf.resize(n);
+ * \endcode
+ * Other types are value-initialized, as by resize().
+ * 
+ * @param count The new size of the vector.
+ */
+void resize_for_overwrite(size_type count){
+  if (count <= m_end){
+    truncate(count);
+    return;
+  }
+  grow_for(count);
+  if constexpr (!std::is_trivially_default_constructible_v<value_type> || !plain_construct) {
+    construct_n(m_storage + m_end, count - m_end);
+  }
+  m_end = count;
+}
+
+/**
+ * @brief Appends the elements of the range [first, last) at the end.
+ * 
+ * The capacity grows at most once, by the growth policy.
+ * 
+ * @param first Iterator to the beginning of the range of elements to append.
+ * @param last Iterator to the end of the range of elements to append.
+ */
+template <typename InputItr>
+void append_range(InputItr first, InputItr last){
+  insert(end(), first, last);
+}
+
+/**
+ * @brief Appends `count` copies of `value` at the end.
+ * 
+ * @param count The number of elements to append.
+ * @param value The value of the appended elements.
+ */
+void append(size_type count, const_reference value){
+  if (count == 0){ return; }
+  if (m_end + count > m_capacity){
+    // `value` may live inside the buffer we are about to release.
+    value_type copy(value);
+    grow_for(m_end + count);
+    construct_n(m_storage + m_end, count, copy);
+  } else {
+    construct_n(m_storage + m_end, count, value);
+  }
+  m_end += count;
 }
 
 /**
@@ -477,10 +1502,15 @@ void shrink_to_fit(){
  */
 template <typename InputItr> 
 void assign(InputItr first, InputItr last) {
-  size_type newSize = std::distance(first, last);
-  if (newSize > capacity()) {reserve(capacity()+newSize);}
-  std::copy(first, last, m_storage);
-  m_end = m_storage+newSize;
+  if constexpr (detail::is_multipass_v<InputItr>) {
+    assign_n(first, std::distance(first, last));
+  } else {
+    // Overwrite the elements we have, then destroy or append the difference.
+    size_type i{0};
+    for (; i < m_end && first != last; ++i, ++first){ m_storage[i] = *first; }
+    truncate(i);
+    for (; first != last; ++first){ emplace_back(*first); }
+  }
 }
 
 /**
@@ -492,11 +1522,20 @@ void assign(InputItr first, InputItr last) {
  * @param value The value to assign to the elements.
  */
 void assign(size_type count, const_reference value) {
-  if (count > capacity()) {
-    reserve(count);
+  if (count > m_capacity) {
+    // `value` may live inside the buffer we are about to release.
+    value_type copy(value);
+    clear();
+    grow_for(count);
+    construct_n(m_storage, count, copy);
+  } else if (count <= m_end) {
+    fill_assign(m_storage, count, value);
+    destroy(m_storage + count, m_storage + m_end);
+  } else {
+    fill_assign(m_storage, m_end, value);
+    construct_n(m_storage + m_end, count - m_end, value);
   }
-  m_end = std::distance(m_storage, m_storage+count);
-  std::fill(begin(), end(), value);
+  m_end = count;
 }
 
 /**
@@ -525,8 +1564,15 @@ void assign(const std::initializer_list<T>& ilist) {
 iterator erase(iterator first, iterator last) {
   if (empty()) { throw std::out_of_range("The container is empty."); }
   if (first < begin() || last > end()) { throw std::out_of_range("Invalid iterators provided."); }
-  auto pointersRange = std::distance(first, last);
-  if (last < end()) { std::copy(last, end(), first); }
+  const size_type pointersRange = last - first;
+  if (pointersRange == 0) { return first; }
+  if constexpr (relocatable) {
+    destroy(&*first, &*first + pointersRange);
+    detail::move_bytes(&*first, m_storage + (last - begin()), end() - last);
+  } else {
+    std::move(last, end(), first);
+    destroy(m_storage + m_end - pointersRange, m_storage + m_end);
+  }
   m_end -= pointersRange;
   return first;
 }
@@ -543,9 +1589,7 @@ iterator erase(iterator first, iterator last) {
  * @throws std::out_of_range if the container is empty or if the provided iterators are invalid.
  */
 iterator erase(const_iterator first, const_iterator last){
-  iterator init{first};
-  iterator end{last};
-  return erase(init, end);
+  return erase(begin() + (first - cbegin()), begin() + (last - cbegin()));
 }
 
 /**
@@ -559,9 +1603,7 @@ iterator erase(const_iterator first, const_iterator last){
  * @throws std::out_of_range if the container is empty or if the provided iterator is invalid.
  */
 iterator erase(const_iterator pos){
-  iterator init{pos};
-  iterator end{pos};
-  return erase(init, end);
+  return erase(begin() + (pos - cbegin()));
 }
 
 /**
@@ -578,6 +1620,181 @@ iterator erase(iterator pos){
   return erase(pos, std::next(pos));
 }
 
+/**
+ * @brief Removes every element for which `pred` returns true.
+ * 
+ * The kept elements are compacted towards the front in a single pass, in
+ * their original order, and the leftover tail is destroyed: O(size()) in
+ * total, where erasing the elements one by one would be O(size()²).
+ * For trivially copyable elements the pass is branchless: every element is
+ * stored and the output position only advances past kept ones. It stays a
+ * scalar loop, since `pred` is opaque; remove() has the SIMD path.
+ * 
+ * @param pred Unary predicate that tells which elements to remove.
+ * @return The number of removed elements.
+ */
+template <typename Pred>
+size_type erase_if(Pred pred){
+  pointer first = std::find_if(m_storage, m_storage + m_end, pred);
+  pointer last = m_storage + m_end;
+  if (first == last){ return 0; }
+  pointer out = first;
+  if constexpr (std::is_trivially_copyable_v<value_type> && plain_construct) {
+    for (pointer in = first + 1; in != last; ++in){
+      // `pred` sees the element itself, so it may take a non-const reference.
+      const bool drop = static_cast<bool>(pred(*in));
+      *out = *in;
+      out += !drop;
+    }
+  } else {
+    for (pointer in = first + 1; in != last; ++in){
+      if (!pred(*in)){ *out++ = std::move(*in); }
+    }
+  }
+  const size_type removed = last - out;
+  truncate(out - m_storage);
+  return removed;
+}
+
+/**
+ * @brief Removes the elements at several indices in a single pass.
+ * 
+ * The runs of kept elements between the removed ones are shifted down once
+ * each, so the cost is O(size()) in total, where k separate erase() calls
+ * would be O(size() * k).
+ * 
+ * @param first Iterator to the beginning of the indices, in strictly ascending order.
+ * @param last Iterator to the end of the indices.
+ * @return The number of removed elements.
+ * @throws std::out_of_range if the indices are not strictly ascending or are not
+ *         below size(); the vector is left untouched.
+ */
+template <typename IdxItr>
+size_type erase_indices(IdxItr first, IdxItr last){
+  size_type next{0}; // Smallest index allowed next.
+  for (IdxItr it = first; it != last; ++it){
+    const size_type idx = *it;
+    if (idx >= m_end || idx < next){ throw std::out_of_range("Invalid indices provided."); }
+    next = idx + 1;
+  }
+  if (first == last){ return 0; }
+
+  size_type out = *first; // Next slot to fill.
+  size_type read = out;   // Next element to keep.
+  auto shift_down = [this, &out, &read](size_type stop) {
+    const size_type run = stop - read;
+    if constexpr (relocatable) {
+      detail::move_bytes(m_storage + out, m_storage + read, run);
+    } else {
+      std::move(m_storage + read, m_storage + stop, m_storage + out);
+    }
+    out += run;
+  };
+  for (; first != last; ++first){
+    const size_type idx = *first;
+    shift_down(idx);
+    if constexpr (relocatable) { destroy_at(m_storage + idx); }
+    read = idx + 1;
+  }
+  shift_down(m_end);
+
+  const size_type removed = m_end - out;
+  if constexpr (relocatable) {
+    m_end = out;
+  } else {
+    truncate(out);
+  }
+  return removed;
+}
+
+/**
+ * @brief Removes the elements whose flag in `mask` is set.
+ * 
+ * @param mask Iterator to size() flags, one per element, convertible to bool.
+ * @return The number of removed elements.
+ */
+template <typename MaskItr>
+size_type erase_mask(MaskItr mask){
+  // erase_if() visits every element exactly once, in order.
+  return erase_if([&mask](const value_type &) { return static_cast<bool>(*mask++); });
+}
+
+/**
+ * @brief Removes the element at `pos` in O(1), without keeping the order.
+ * 
+ * The last element is moved into the hole, instead of shifting the whole
+ * tail as erase() does. Trivially relocatable elements are moved as bytes,
+ * so no constructor or assignment runs; only the removed element's
+ * destructor.
+ * 
+ * @param pos Iterator pointing to the element to erase.
+ * @return An iterator to the element that took its place (or end()).
+ * @throws std::out_of_range if the container is empty or if the provided iterator is invalid.
+ */
+iterator unordered_erase(const_iterator pos){
+  if (empty()) { throw std::out_of_range("The container is empty."); }
+  if (pos < cbegin() || pos >= cend()) { throw std::out_of_range("Invalid iterators provided."); }
+  const size_type idx = pos - cbegin();
+  pointer hole = m_storage + idx;
+  pointer last = m_storage + m_end - 1;
+  if constexpr (relocatable) {
+    destroy_at(hole);
+    if (hole != last){ detail::move_bytes(hole, last, 1); }
+  } else {
+    if (hole != last){ *hole = std::move(*last); }
+    destroy_at(last);
+  }
+  --m_end;
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes every element for which `pred` returns true, without keeping the order.
+ * 
+ * Each removed element is replaced by a kept one taken from the back, so
+ * only as many elements are moved as there are holes below the new end.
+ * 
+ * @param pred Unary predicate that tells which elements to remove.
+ * @return The number of removed elements.
+ */
+template <typename Pred>
+size_type unordered_erase_if(Pred pred){
+  pointer first = m_storage;
+  pointer last = m_storage + m_end;
+  while ((first = std::find_if(first, last, pred)) != last){
+    // Find the last element to keep, behind the hole.
+    do { --last; } while (last != first && pred(*last));
+    if (last == first){ break; }
+    *first = std::move(*last);
+    ++first;
+  }
+  const size_type removed = m_end - (first - m_storage);
+  truncate(first - m_storage);
+  return removed;
+}
+
+/**
+ * @brief Removes every element equal to `value`.
+ * 
+ * Arithmetic elements are compacted by detail::remove_value(), which skips
+ * over blocks without a match with SIMD compares and stores.
+ * 
+ * @param value The value to remove; it may be an element of the vector.
+ * @return The number of removed elements.
+ */
+size_type remove(const_reference value){
+  // Compare with a copy: `value` may be overwritten by the compaction.
+  const value_type copy(value);
+  if constexpr (detail::is_fast_removable_v<value_type> && plain_construct) {
+    const size_type kept = detail::remove_value(m_storage, m_end, copy);
+    const size_type removed = m_end - kept;
+    truncate(kept);
+    return removed;
+  } else {
+    return erase_if([&copy](const value_type &elem) { return elem == copy; });
+  }
+}
+
   // [V] Element access
 const_reference back() const {
   if(empty()){ throw std::length_error("there is no element in array");}
@@ -640,47 +1857,299 @@ reference at(size_type pos) {
 
 pointer data() { return m_storage; }
 
-const_reference data() const { return m_storage; }
+const_pointer data() const { return m_storage; }
 
   // [VII] Friend functions.
-friend std::ostream &operator<<(std::ostream &os, const vector<T> &vec) {
-    // O que eu quero imprimir???
+friend std::ostream &operator<<(std::ostream &os, const vector &vec) {
+  // Only the live elements are printed; the remaining capacity is raw memory.
   os << "{ ";
-  for (auto i{0U}; i < vec.m_capacity; ++i) {
-    if (i == vec.m_end) {
-      os << "| ";
-    }
+  for (auto i{0U}; i < vec.m_end; ++i) {
     os << vec.m_storage[i] << " ";
   }
-  os << "}, m_end=" << vec.m_end << ", m_capacity=" << vec.m_capacity;
+  os << "| }, m_end=" << vec.m_end << ", m_capacity=" << vec.m_capacity;
 
   return os;
 }
 
-friend void swap(vector<T> &first, vector<T> &second) noexcept {
+friend void swap(vector &first, vector &second) noexcept {
     // enable ADL
   using std::swap;
 
-    // Swap each member of the class.
+    // Swap each member of the class. Allocators that do not propagate on
+    // swap must compare equal, otherwise the behavior is undefined.
+  if constexpr (alloc_traits::propagate_on_container_swap::value) {
+    swap(first.m_alloc, second.m_alloc);
+  }
   swap(first.m_end, second.m_end);
   swap(first.m_capacity, second.m_capacity);
   swap(first.m_storage, second.m_storage);
 }
 
 private:
+/// How the elements are built and destroyed (see detail::alloc_ops).
+using element_ops = detail::alloc_ops<Allocator>;
+/// Whether constructing through the allocator is the same as placement new.
+static constexpr bool plain_construct = element_ops::plain;
+/// Whether elements may be moved around as raw bytes.
+static constexpr bool relocatable = element_ops::relocatable;
+/// Whether copies of one value may be written as raw bytes (see bulk::fill).
+static constexpr bool bitwise_fill = element_ops::bitwise_copyable;
+
+/// The element policy of this vector, for the helpers in sc::detail.
+element_ops ops() { return {m_alloc}; }
+
+/// Allocates raw (uninitialized) memory for `n` elements.
+pointer allocate(size_type n){
+  if (n == 0){ return nullptr; }
+  return alloc_traits::allocate(m_alloc, n);
+}
+
+/// Rounds `n` up to the allocator's capacity granule (see sc::aligned_allocator).
+static constexpr size_type padded(size_type n){
+  constexpr size_type granule = detail::capacity_granule<Allocator>::value;
+  if constexpr (granule == 1) { return n; }
+  else { return (n + granule - 1) / granule * granule; }
+}
+
+/// Gives an empty vector a storage area for at least `n` elements.
+void init_storage(size_type n){
+  m_capacity = padded(n);
+  m_storage = allocate(m_capacity);
+}
+
+/// Frees a storage area of `cap` slots whose elements are already gone.
+void deallocate(pointer storage, size_type cap){
+  if (storage != nullptr){ alloc_traits::deallocate(m_alloc, storage, cap); }
+}
+
+/// Constructs an element in the raw slot `p`.
+template <typename... Args>
+void construct_at(pointer p, Args &&...args){
+  alloc_traits::construct(m_alloc, p, std::forward<Args>(args)...);
+}
+
+/// Destroys the element at `p`.
+void destroy_at(pointer p){
+  alloc_traits::destroy(m_alloc, p);
+}
+
+/// Destroys the elements in `[first, last)`.
+void destroy(pointer first, pointer last){ detail::destroy_range(ops(), first, last); }
+
+/**
+ * @brief Destroys the `count` live elements of `storage` and frees its `cap` slots.
+ * 
+ * The reclamation policy may defer that work, in which case it runs on a
+ * copy of the allocator.
+ */
+void release(pointer storage, size_type count, size_type cap){
+  if (storage != nullptr && reclaim_policy::defer(cap * sizeof(value_type))){
+    reclaim_policy::submit([alloc = m_alloc, storage, count, cap]() mutable {
+      detail::destroy_range(element_ops{alloc}, storage, storage + count);
+      alloc_traits::deallocate(alloc, storage, cap);
+    });
+    return;
+  }
+  destroy(storage, storage + count);
+  deallocate(storage, cap);
+}
+
+/// Destroys the elements past the first `count` ones (`count <= size()`).
+void truncate(size_type count){
+  destroy(m_storage + count, m_storage + m_end);
+  m_end = count;
+}
+
+/// Takes over the storage of `other`, which is left empty.
+void steal(vector &other) noexcept {
+  m_end = other.m_end;
+  m_capacity = other.m_capacity;
+  m_storage = other.m_storage;
+  other.m_end = 0;
+  other.m_capacity = 0;
+  other.m_storage = nullptr;
+}
+
+/// Constructs `n` elements read from `first` into the raw memory at `dest`.
+template <typename InputItr>
+void construct_copies(InputItr first, size_type n, pointer dest){
+  detail::construct_copies(ops(), first, n, dest);
+}
+
+/// Constructs `n` elements from the same `args` (none: value-initialized) at `dest`.
+template <typename... Args>
+void construct_n(pointer dest, size_type n, const Args &...args){
+  detail::construct_n(ops(), dest, n, args...);
+}
+
+/// Assigns `value` to the `n` live elements at `dest`; `value` may be one of them.
+void fill_assign(pointer dest, size_type n, const_reference value){
+  if constexpr (bitwise_fill) {
+    bulk::fill(dest, n, value);
+  } else {
+    std::fill_n(dest, n, value);
+  }
+}
+
+/// Assigns `value` to slot `idx` if it is below `live_end`, or constructs it there.
+template <typename U>
+void place(size_type idx, size_type live_end, U &&value){
+  if (idx < live_end){
+    m_storage[idx] = std::forward<U>(value);
+  } else {
+    construct_at(m_storage + idx, std::forward<U>(value));
+  }
+}
+
+/// Releases a storage area whose `count` elements were transferred by detail::transfer().
+void release_relocated(pointer storage, size_type count, size_type cap){
+  release(storage, relocatable ? 0 : count, cap);
+}
+
+/**
+ * @brief Moves the elements to a storage area of `new_cap` slots.
+ * 
+ * When the elements are trivially relocatable and the allocator offers
+ * `reallocate()` (see sc::malloc_allocator), the block is resized in place
+ * of allocating a new one and copying the elements over.
+ * 
+ * @param new_cap The capacity of the new storage, which must be `>= size()`;
+ *        it is rounded up to the capacity granule of the allocator.
+ */
+void reallocate(size_type new_cap){
+  new_cap = padded(new_cap);
+  if constexpr (relocatable && detail::has_reallocate<Allocator>::value) {
+    if (m_storage != nullptr && new_cap != 0){
+      m_storage = m_alloc.reallocate(m_storage, m_capacity, new_cap);
+      m_capacity = new_cap;
+      return;
+    }
+  }
+  pointer new_storage = allocate(new_cap);
+  try {
+    detail::transfer(ops(), m_storage, m_storage + m_end, new_storage);
+  } catch (...) {
+    deallocate(new_storage, new_cap);
+    throw;
+  }
+  release_relocated(m_storage, m_end, m_capacity);
+  m_storage = new_storage;
+  m_capacity = new_cap;
+}
+
+/**
+ * @brief Inserts a new element at `idx` into a freshly grown storage area.
+ * 
+ * The new element is constructed first, while the old buffer is still alive,
+ * so the arguments may safely refer to elements of this very vector. Then the
+ * old elements are relocated around it.
+ * 
+ * @param idx Index of the new element.
+ * @param args Arguments forwarded to the constructor of the new element.
+ */
+template <typename... Args>
+void realloc_emplace(size_type idx, Args &&...args){
+  const size_type new_cap = padded(growth_policy::next_capacity(m_capacity, m_end + 1));
+  pointer new_storage = allocate(new_cap);
+  try {
+    construct_at(new_storage + idx, std::forward<Args>(args)...);
+  } catch (...) {
+    deallocate(new_storage, new_cap);
+    throw;
+  }
+  try {
+    detail::transfer_around(ops(), m_storage, m_end, idx, 1, new_storage);
+  } catch (...) {
+    destroy_at(new_storage + idx);
+    deallocate(new_storage, new_cap);
+    throw;
+  }
+  release_relocated(m_storage, m_end, m_capacity);
+
+  m_storage = new_storage;
+  m_capacity = new_cap;
+  ++m_end;
+}
+
+/**
+ * @brief Makes sure the vector can hold at least `required` elements.
+ * 
+ * When the current capacity is not enough, the new capacity is chosen by the
+ * growth policy, so a sequence of appends only reallocates O(log n) times.
+ * 
+ * @param required The minimum capacity needed.
+ */
+void grow_for(size_type required){
+  if (required <= m_capacity){ return; }
+  reserve(growth_policy::next_capacity(m_capacity, required));
+}
+
+/**
+ * @brief Shifts the elements in `[idx, size())` `n` slots to the right.
+ * 
+ * On return the slots `[idx, idx + n)` hold no live object, so the caller must
+ * construct the new elements there and then add `n` to `m_end`. The capacity
+ * must already be at least `size() + n`.
+ */
+void open_gap(size_type idx, size_type n){ detail::open_gap(ops(), m_storage, m_end, idx, n); }
+
+/// Undoes open_gap(idx, n) when the gap could not be filled (see detail::close_gap).
+void close_gap(size_type idx, size_type n){ detail::close_gap(ops(), m_storage, m_end, idx, n); }
+
+/**
+ * @brief Replaces the contents with `n` elements read from `first`.
+ * 
+ * Live elements are reused through assignment; only the difference in size
+ * is constructed or destroyed.
+ */
+template <typename InputItr>
+void assign_n(InputItr first, size_type n){
+  if (n > m_capacity) {
+    clear();
+    grow_for(n);
+  }
+  detail::assign_n(ops(), m_storage, m_end, first, n);
+  m_end = n;
+}
+
+/**
+ * @brief Inserts a single-pass range at `idx`, reading it only once.
+ * 
+ * The elements are appended at the end as they are read, then rotated into
+ * place, which is O(size() - idx) on top of the appends. If reading or
+ * constructing an element throws, the ones appended so far are destroyed,
+ * so the vector keeps its old elements (its capacity may have grown).
+ */
+template <typename InputItr>
+iterator insert_single_pass(size_type idx, InputItr first, InputItr last){
+  const size_type old_end = m_end;
+  try {
+    for (; first != last; ++first){ emplace_back(*first); }
+  } catch (...) {
+    truncate(old_end);
+    throw;
+  }
+  std::rotate(m_storage + idx, m_storage + old_end, m_storage + m_end);
+  return begin() + idx;
+}
+
   size_type m_end;      //!< The list's current size.
   size_type m_capacity; //!< The list's storage capacity.
-  T *m_storage;         //!< The list's data storage area.
+  T *m_storage;         //!< The list's data storage area (raw memory).
+  Allocator m_alloc;    //!< Where the storage area comes from.
 };
 
 // [VI] Operators ================================= TODO ====================================
-template <typename T>
-bool operator==(const vector<T> &lhs, const vector<T> &rhs) {
+template <typename T, typename A, typename G, typename R>
+bool operator==(const vector<T, A, G, R> &lhs, const vector<T, A, G, R> &rhs) {
   if (lhs.size() != rhs.size()) {
     return false;
   }
+  if constexpr (detail::is_fast_comparable_v<T>) {
+    return detail::equal_elements(lhs.data(), rhs.data(), lhs.size());
+  }
 
-  for (typename vector<T>::size_type i = 0; i < lhs.size(); ++i) {
+  for (typename vector<T, A, G, R>::size_type i = 0; i < lhs.size(); ++i) {
     if (lhs[i] != rhs[i]) {
       return false;
     }
@@ -688,11 +2157,70 @@ bool operator==(const vector<T> &lhs, const vector<T> &rhs) {
 
   return true;
 }
-template <typename T>
-bool operator!=(const vector<T> &lhs, const vector<T> &rhs) {
+template <typename T, typename A, typename G, typename R>
+bool operator!=(const vector<T, A, G, R> &lhs, const vector<T, A, G, R> &rhs) {
   return !(lhs == rhs);
 }
 
+/**
+ * @brief Compares two vectors lexicographically.
+ * 
+ * Arithmetic elements go through a vectorized search for the first mismatch,
+ * so long common prefixes are skipped at memory speed.
+ * 
+ * @return The ordering of the first pair of elements that differ, or of the sizes if one vector is a prefix of the other.
+ */
+template <typename T, typename A, typename G, typename R>
+  requires detail::synth_comparable<T>
+detail::synth_three_way_result<T> operator<=>(const vector<T, A, G, R> &lhs, const vector<T, A, G, R> &rhs) {
+  const std::size_t common = std::min(lhs.size(), rhs.size());
+  if constexpr (detail::is_fast_comparable_v<T>) {
+    const std::size_t i = detail::mismatch_index(lhs.data(), rhs.data(), common);
+    if (i != common) { return lhs[i] <=> rhs[i]; }
+  } else {
+    for (std::size_t i{0}; i < common; ++i) {
+      const auto order = detail::synth_three_way(lhs[i], rhs[i]);
+      if (order != 0) { return order; }
+    }
+  }
+  return lhs.size() <=> rhs.size();
+}
+
+/// Erases every element of `vec` for which `pred` is true; see vector::erase_if().
+template <typename T, typename A, typename G, typename R, typename Pred>
+typename vector<T, A, G, R>::size_type erase_if(vector<T, A, G, R> &vec, Pred pred) {
+  return vec.erase_if(pred);
+}
+
+/// Erases every element of `vec` equal to `value`; see vector::remove().
+template <typename T, typename A, typename G, typename R, typename U>
+typename vector<T, A, G, R>::size_type erase(vector<T, A, G, R> &vec, const U &value) {
+  if constexpr (std::is_same_v<U, T>) {
+    return vec.remove(value); // `value` may be an element of `vec`.
+  } else {
+    return vec.erase_if([&value](const T &elem) { return elem == value; });
+  }
+}
+
+/// Containers that take their memory from a std::pmr::memory_resource.
+namespace pmr {
+/*!
+ * sc::vector on a std::pmr::polymorphic_allocator. The memory resource is
+ * chosen at run time, e.g. an sc::pmr::arena_resource shared by all the
+ * vectors built while serving a request.
+ */
+template <typename T, typename GrowthPolicy = growth::doubling>
+using vector = sc::vector<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+} // namespace pmr.
+
+/*!
+ * sc::vector whose `data()` is always `Align`-byte aligned; with `PadCapacity`
+ * the capacity is also a whole number of `Align`-byte blocks.
+ */
+template <typename T, std::size_t Align = 64, bool PadCapacity = false,
+          typename GrowthPolicy = growth::doubling>
+using aligned_vector = sc::vector<T, aligned_allocator<T, Align, PadCapacity>, GrowthPolicy>;
+
 } // namespace sc.
 
 #endif
\ No newline at end of file
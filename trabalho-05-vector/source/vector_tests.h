@@ -7,9 +7,13 @@
 #include "tm/test_manager.h"
 
 #include "vector.h"
+#include "static_vector.h"
 #define which_lib sc
 // To run tests with the STL's vector, uncomment the line below.
 // #define which_lib std
+// To run tests with sc::static_vector, uncomment the line below (the capacity
+// checks do not apply, since its capacity is fixed).
+// #define which_lib sc::fixed_capacity
 
 #define YES 1
 #define NO 0
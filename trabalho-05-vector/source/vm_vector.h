@@ -0,0 +1,641 @@
+#ifndef _VM_VECTOR_H_
+#define _VM_VECTOR_H_
+
+#include <sys/mman.h> // mmap, mprotect, madvise, munmap
+#include <unistd.h>   // sysconf
+
+#include "vector.h" // sc::MyForwardIterator, sc::growth, sc::is_trivially_relocatable
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Vector on a reserved range of virtual memory, which never moves its elements.
+/*!
+ * On construction sc::vm_vector reserves address space for `max_size()`
+ * elements with `mmap(PROT_NONE)`: no physical memory is used yet. As the
+ * vector grows, pages are committed at the end of the range (made readable
+ * and writable) following the growth policy, so growth is never a
+ * reallocation:
+ *
+ *   - data() never changes, and pointers, references and iterators to the
+ *     elements stay valid until the element is erased;
+ *   - reserve() and push_back() never copy or move an element, so the peak
+ *     memory use never doubles;
+ *   - shrink_to_fit() hands the pages past size() back to the kernel with
+ *     `madvise(MADV_DONTNEED)` and decommits them.
+ *
+ * The price is a fixed upper bound: growing past max_size() throws
+ * `std::length_error`. Since only address space is reserved, the bound may
+ * be generous, but it still counts against `ulimit -v` and, with
+ * `vm.overcommit_memory = 2`, against the commit limit. The default is
+ * 1 GiB; pass `max_elements` to the constructor for larger vectors.
+ *
+ *     [ e0 e1 ... e(n-1) | committed, raw | reserved, PROT_NONE ...... ]
+ *       data()   size()     capacity()                      max_size()
+ *
+ * Needs a POSIX system (mmap). The elements are created with placement new.
+ *
+ * \tparam T The type of the elements.
+ * \tparam GrowthPolicy How the committed capacity grows (see sc::growth).
+ */
+template <typename T, typename GrowthPolicy = growth::doubling>
+class vm_vector {
+  //=== Aliases
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using const_pointer = const value_type *; //!< Pointer to a const value.
+  using reference = value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value stored in the container.
+  using iterator = MyForwardIterator<value_type>; //!< The iterator.
+  using const_iterator = MyForwardIterator<const value_type>; //!< The const_iterator.
+  using growth_policy = GrowthPolicy; //!< The capacity growth policy.
+
+  /// Bytes of address space reserved when no maximum size is given.
+  static constexpr std::size_t default_reservation = std::size_t{1} << 30;
+
+  //=== [I] SPECIAL MEMBERS
+/**
+ * @brief Constructs an empty vm_vector with the default reservation.
+ */
+vm_vector() : vm_vector(default_reservation / sizeof(T)) {}
+
+/**
+ * @brief Constructs an empty vm_vector that may hold up to `max_elements`.
+ *
+ * Only address space is reserved; no page is committed yet.
+ *
+ * @param max_elements The maximum size (rounded up to whole pages).
+ * @throws std::bad_alloc if the address space cannot be reserved.
+ */
+explicit vm_vector(size_type max_elements) { reserve_range(max_elements); }
+
+/**
+ * @brief Constructs a vm_vector with the elements of an initializer list.
+ *
+ * @param il The initializer list.
+ * @param max_elements The maximum size.
+ */
+vm_vector(const std::initializer_list<T> &il,
+          size_type max_elements = default_reservation / sizeof(T))
+  : vm_vector(il.begin(), il.end(), max_elements) {}
+
+/**
+ * @brief Constructs a vm_vector from the range [first, last).
+ *
+ * @param first Iterator to the beginning of the range.
+ * @param last Iterator to the end of the range.
+ * @param max_elements The maximum size.
+ * @throws std::length_error if the range is longer than `max_elements`.
+ */
+template <typename InputItr>
+vm_vector(InputItr first, InputItr last,
+          size_type max_elements = default_reservation / sizeof(T))
+  : vm_vector(max_elements) {
+  assign(first, last);
+}
+
+/**
+ * @brief Copy constructor; the copy reserves as much address space as `other`.
+ *
+ * @param other The vm_vector to copy from.
+ */
+vm_vector(const vm_vector &other) : vm_vector(other.m_max) {
+  assign(other.begin(), other.end());
+}
+
+/**
+ * @brief Move constructor: takes over the reservation of `other` in O(1).
+ *
+ * `other` is left empty and without any reservation, so it may only be
+ * assigned to or destroyed; an assignment gives it a new reservation.
+ *
+ * @param other The vm_vector to move from.
+ */
+vm_vector(vm_vector &&other) noexcept { steal(other); }
+
+/**
+ * @brief Destructor: destroys the elements and unmaps the whole range.
+ */
+~vm_vector() { release(); }
+
+/**
+ * @brief Copy assignment operator; the reservation of `*this` is kept.
+ *
+ * Without a reservation (e.g. when moved from), `*this` reserves as much
+ * address space as `rhs`.
+ *
+ * @param rhs The vm_vector to copy from.
+ * @return Reference to the modified vm_vector.
+ * @throws std::length_error if `rhs` does not fit in the reservation.
+ */
+vm_vector &operator=(const vm_vector &rhs) {
+  if (this != &rhs) {
+    reserve_if_unset(rhs.m_max);
+    assign(rhs.begin(), rhs.end());
+  }
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator: takes over the reservation of `rhs`.
+ *
+ * @param rhs The vm_vector to move from.
+ * @return Reference to the modified vm_vector.
+ */
+vm_vector &operator=(vm_vector &&rhs) noexcept {
+  if (this != &rhs) {
+    release();
+    steal(rhs);
+  }
+  return *this;
+}
+
+  //=== [II] ITERATORS
+iterator begin() { return iterator{m_storage}; }
+iterator end() { return iterator(m_storage + m_end); }
+const_iterator begin() const { return const_iterator(m_storage); }
+const_iterator end() const { return const_iterator(m_storage + m_end); }
+const_iterator cbegin() const { return const_iterator(m_storage); }
+const_iterator cend() const { return const_iterator(m_storage + m_end); }
+
+  // [III] Capacity
+[[nodiscard]] bool full() const { return m_end == capacity(); }
+[[nodiscard]] size_type size() const { return m_end; }
+/// Number of elements that fit in the committed pages.
+[[nodiscard]] size_type capacity() const { return m_committed / sizeof(T); }
+/// Number of elements that fit in the reserved range.
+[[nodiscard]] size_type max_size() const { return m_max; }
+[[nodiscard]] bool empty() const { return m_end == 0; }
+
+  // [IV] Modifiers
+void clear(){
+  destroy(m_storage, m_storage + m_end);
+  m_end = 0;
+}
+
+/**
+ * @brief Inserts an element at the beginning.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the vm_vector is at max_size().
+ */
+void push_front(const_reference value){ emplace(cbegin(), value); }
+
+/**
+ * @brief Inserts an element at the beginning, moving it in.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the vm_vector is at max_size().
+ */
+void push_front(value_type &&value){ emplace(cbegin(), std::move(value)); }
+
+/**
+ * @brief Inserts an element at the end.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the vm_vector is at max_size().
+ */
+void push_back(const_reference value){ emplace_back(value); }
+
+/**
+ * @brief Inserts an element at the end, moving it in.
+ *
+ * @param value The value to be inserted.
+ * @throws std::length_error if the vm_vector is at max_size().
+ */
+void push_back(value_type &&value){ emplace_back(std::move(value)); }
+
+/**
+ * @brief Constructs an element in place at the end.
+ *
+ * Never moves the other elements: at most, more pages are committed.
+ *
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return A reference to the new element.
+ * @throws std::length_error if the vm_vector is at max_size().
+ */
+template <typename... Args>
+reference emplace_back(Args &&...args){
+  grow_for(m_end + 1);
+  construct_at(m_storage + m_end, std::forward<Args>(args)...);
+  return m_storage[m_end++];
+}
+
+/**
+ * @brief Constructs an element in place right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param args Arguments forwarded to the constructor of the new element.
+ * @return An iterator pointing to the new element.
+ * @throws std::length_error if the vm_vector is at max_size().
+ */
+template <typename... Args>
+iterator emplace(const_iterator pos, Args &&...args){
+  const size_type idx = pos - cbegin();
+  grow_for(m_end + 1);
+  if (idx == m_end){
+    construct_at(m_storage + m_end, std::forward<Args>(args)...);
+  } else {
+    // The arguments may refer to an element that is about to be shifted.
+    value_type tmp(std::forward<Args>(args)...);
+    open_gap(idx, 1);
+    try {
+      construct_at(m_storage + idx, std::move(tmp));
+    } catch (...) {
+      close_gap(idx, 1);
+      throw;
+    }
+  }
+  ++m_end;
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes the last element.
+ *
+ * @throws std::length_error if the vm_vector is empty.
+ */
+void pop_back(){
+  if(empty()){throw std::length_error("POP_BACK(EMPTY)\n");}
+  --m_end;
+  destroy(m_storage + m_end, m_storage + m_end + 1);
+}
+
+/**
+ * @brief Removes the first element.
+ *
+ * @throws std::length_error if the vm_vector is empty.
+ */
+void pop_front(){
+  if(empty()){throw std::length_error("POP_FRONT(EMPTY)\n");}
+  erase(cbegin());
+}
+
+/**
+ * @brief Inserts the range [first, last) right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the elements will be inserted.
+ * @param first Iterator to the beginning of the range of elements to insert.
+ * @param last Iterator to the end of the range of elements to insert.
+ * @return An iterator pointing to the first inserted element, or pos if the range is empty.
+ * @throws std::length_error if the elements do not fit in max_size().
+ */
+template<typename InputItr>
+iterator insert(const_iterator pos, InputItr first, InputItr last){
+  const size_type idx = pos - cbegin();
+  const size_type count = std::distance(first, last);
+  grow_for(m_end + count);
+  open_gap(idx, count);
+  size_type i{0};
+  try {
+    for (; i < count; ++i, ++first){
+      construct_at(m_storage + idx + i, *first);
+    }
+  } catch (...) {
+    destroy(m_storage + idx, m_storage + idx + i);
+    close_gap(idx, count);
+    throw;
+  }
+  m_end += count;
+  return begin() + idx;
+}
+
+/**
+ * @brief Inserts the elements of `ilist` right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the elements will be inserted.
+ * @param ilist Initializer list containing elements to insert.
+ * @return An iterator pointing to the first inserted element, or pos if the list is empty.
+ * @throws std::length_error if the elements do not fit in max_size().
+ */
+iterator insert(const_iterator pos, const std::initializer_list<value_type> &ilist){
+  return insert(pos, ilist.begin(), ilist.end());
+}
+
+/**
+ * @brief Inserts a copy of `value` right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param value The value to be inserted.
+ * @return An iterator pointing to the inserted element.
+ * @throws std::length_error if the vm_vector is at max_size().
+ */
+iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+
+/**
+ * @brief Moves `value` in right before `pos`.
+ *
+ * @param pos Iterator indicating the position where the element will be inserted.
+ * @param value The value to be inserted.
+ * @return An iterator pointing to the inserted element.
+ * @throws std::length_error if the vm_vector is at max_size().
+ */
+iterator insert(const_iterator pos, value_type &&value) { return emplace(pos, std::move(value)); }
+
+/**
+ * @brief Commits pages for at least `new_cap` elements.
+ *
+ * No element is moved or constructed.
+ *
+ * @param new_cap The requested capacity.
+ * @throws std::length_error if `new_cap > max_size()`.
+ * @throws std::bad_alloc if the kernel refuses to commit the pages.
+ */
+void reserve(size_type new_cap){
+  check_room(new_cap);
+  if (new_cap > capacity()){ commit(new_cap * sizeof(T)); }
+}
+
+/**
+ * @brief Decommits the pages past size().
+ *
+ * Their memory goes back to the kernel (`madvise(MADV_DONTNEED)`); the
+ * address range stays reserved, so the vector may grow again in place.
+ */
+void shrink_to_fit(){
+  const std::size_t keep = round_to_pages(m_end * sizeof(T));
+  if (keep >= m_committed){ return; }
+  auto *tail = reinterpret_cast<std::byte *>(m_storage) + keep;
+  ::madvise(tail, m_committed - keep, MADV_DONTNEED);
+  ::mprotect(tail, m_committed - keep, PROT_NONE);
+  m_committed = keep;
+}
+
+/**
+ * @brief Replaces the contents with the elements from [first, last).
+ *
+ * A vm_vector without a reservation (moved from) gets the default one.
+ *
+ * @param first Iterator to the beginning of the range of elements to assign.
+ * @param last Iterator to the end of the range of elements to assign.
+ * @throws std::length_error if the range is longer than max_size().
+ */
+template <typename InputItr>
+void assign(InputItr first, InputItr last) {
+  const size_type count = std::distance(first, last);
+  if (count != 0) { reserve_if_unset(default_reservation / sizeof(T)); }
+  reserve(count);
+  detail::assign_n(ops(), m_storage, m_end, first, count);
+  m_end = count;
+}
+
+/**
+ * @brief Replaces the contents with `count` copies of `value`.
+ *
+ * A vm_vector without a reservation (moved from) gets the default one.
+ *
+ * @param count The number of elements to assign.
+ * @param value The value to assign to the elements.
+ * @throws std::length_error if `count > max_size()`.
+ */
+void assign(size_type count, const_reference value) {
+  if (count != 0) { reserve_if_unset(default_reservation / sizeof(T)); }
+  reserve(count);
+  size_type i{0};
+  for (; i < count and i < m_end; ++i){ m_storage[i] = value; }
+  for (; i < count; ++i, ++m_end){ construct_at(m_storage + i, value); }
+  destroy(m_storage + count, m_storage + m_end);
+  m_end = count;
+}
+
+/**
+ * @brief Replaces the contents with the elements of `ilist`.
+ *
+ * @param ilist Initializer list containing elements to assign.
+ * @throws std::length_error if the list is longer than max_size().
+ */
+void assign(const std::initializer_list<T> &ilist) {
+  assign(ilist.begin(), ilist.end());
+}
+
+/**
+ * @brief Removes the elements in [first, last).
+ *
+ * @param first Iterator pointing to the beginning of the range to erase.
+ * @param last Iterator pointing to the end of the range to erase.
+ * @return An iterator pointing to the position of the first erased element.
+ * @throws std::out_of_range if the container is empty or if the provided iterators are invalid.
+ */
+iterator erase(const_iterator first, const_iterator last) {
+  if (empty()) { throw std::out_of_range("The container is empty."); }
+  if (first < cbegin() || last > cend()) { throw std::out_of_range("Invalid iterators provided."); }
+  const size_type idx = first - cbegin();
+  const size_type count = last - first;
+  if (count == 0) { return begin() + idx; }
+  if constexpr (is_trivially_relocatable_v<value_type>) {
+    destroy(m_storage + idx, m_storage + idx + count);
+    detail::move_bytes(m_storage + idx, m_storage + idx + count, m_end - idx - count);
+  } else {
+    std::move(m_storage + idx + count, m_storage + m_end, m_storage + idx);
+    destroy(m_storage + m_end - count, m_storage + m_end);
+  }
+  m_end -= count;
+  return begin() + idx;
+}
+
+/**
+ * @brief Removes the element at `pos`.
+ *
+ * @param pos Iterator pointing to the position of the element to erase.
+ * @return An iterator pointing to the position of the erased element.
+ * @throws std::out_of_range if the container is empty or if the provided iterator is invalid.
+ */
+iterator erase(const_iterator pos){ return erase(pos, pos + 1); }
+
+  // [V] Element access
+const_reference back() const {
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_storage[m_end - 1];
+}
+
+const_reference front() const{
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_storage[0];
+}
+
+reference back(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_storage[m_end - 1];
+}
+
+reference front(){
+  if(empty()){ throw std::length_error("there is no element in array");}
+  return m_storage[0];
+}
+
+const_reference operator[](size_type idx) const { return m_storage[idx]; }
+reference operator[](size_type idx) { return m_storage[idx]; }
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the vm_vector is empty.
+ * @throws std::out_of_range if pos is not within the range of the vm_vector.
+ */
+const_reference at(size_type pos) const {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_end) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return m_storage[pos];
+}
+
+/**
+ * @brief Accesses the element at `pos` with bounds checking.
+ *
+ * @param pos The position of the element to access.
+ * @return A reference to the element at the specified position.
+ * @throws std::length_error if the vm_vector is empty.
+ * @throws std::out_of_range if pos is not within the range of the vm_vector.
+ */
+reference at(size_type pos) {
+  if (empty()) { throw std::length_error("there is no element in array"); }
+  if (pos >= m_end) { throw std::out_of_range("dunno what u looking for...\nu should stop it"); }
+  return m_storage[pos];
+}
+
+pointer data() { return m_storage; }
+
+const_pointer data() const { return m_storage; }
+
+  // [VII] Friend functions.
+friend std::ostream &operator<<(std::ostream &os, const vm_vector &vec) {
+  os << "{ ";
+  for (auto i{0U}; i < vec.m_end; ++i) {
+    os << vec[i] << " ";
+  }
+  os << "| }, m_end=" << vec.m_end << ", m_capacity=" << vec.capacity()
+     << ", max_size=" << vec.m_max;
+  return os;
+}
+
+/// Swaps the reservations of two vm_vectors in O(1).
+friend void swap(vm_vector &first, vm_vector &second) noexcept {
+  std::swap(first.m_storage, second.m_storage);
+  std::swap(first.m_end, second.m_end);
+  std::swap(first.m_committed, second.m_committed);
+  std::swap(first.m_reserved, second.m_reserved);
+  std::swap(first.m_max, second.m_max);
+}
+
+private:
+/// Size of a page of virtual memory.
+static std::size_t page_size() {
+  static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+/// Rounds `bytes` up to whole pages.
+static std::size_t round_to_pages(std::size_t bytes) {
+  const std::size_t page = page_size();
+  return (bytes + page - 1) / page * page;
+}
+
+/// Reserves (without committing) address space for `max_elements`.
+void reserve_range(size_type max_elements){
+  if (max_elements > std::numeric_limits<std::size_t>::max() / sizeof(T) - page_size()) {
+    throw std::length_error("vm_vector reservation too large");
+  }
+  m_reserved = round_to_pages(max_elements * sizeof(T));
+  if (m_reserved == 0){ return; }
+  void *range = ::mmap(nullptr, m_reserved, PROT_NONE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (range == MAP_FAILED){
+    m_reserved = 0;
+    throw std::bad_alloc();
+  }
+  m_storage = static_cast<pointer>(range);
+  m_max = m_reserved / sizeof(T);
+}
+
+/// Reserves a range for `max_elements` if there is none (e.g. after a move).
+void reserve_if_unset(size_type max_elements){
+  if (m_storage == nullptr){ reserve_range(max_elements); }
+}
+
+/// Makes the first `bytes` of the range (rounded up to pages) usable.
+void commit(std::size_t bytes){
+  bytes = std::min(round_to_pages(bytes), m_reserved);
+  if (bytes <= m_committed){ return; }
+  auto *first = reinterpret_cast<std::byte *>(m_storage) + m_committed;
+  if (::mprotect(first, bytes - m_committed, PROT_READ | PROT_WRITE) != 0){
+    throw std::bad_alloc();
+  }
+  m_committed = bytes;
+}
+
+/// Throws when `count` elements would not fit in the reservation.
+void check_room(size_type count) const {
+  if (count > m_max) { throw std::length_error("vm_vector reservation exceeded"); }
+}
+
+/// Commits room for `required` elements, growing as the growth policy says.
+void grow_for(size_type required){
+  if (required <= capacity()){ return; }
+  check_room(required);
+  const size_type target = growth_policy::next_capacity(capacity(), required);
+  commit(std::min(target, m_max) * sizeof(T));
+}
+
+/// How the elements are built and destroyed: placement new, no allocator.
+using element_ops = detail::placement_ops<value_type>;
+
+static element_ops ops() { return {}; }
+
+/// Constructs an element in the raw slot `p`.
+template <typename... Args>
+void construct_at(pointer p, Args &&...args){ ops().construct(p, std::forward<Args>(args)...); }
+
+/// Destroys the elements in `[first, last)`.
+void destroy(pointer first, pointer last){ detail::destroy_range(ops(), first, last); }
+
+/// Shifts `[idx, size())` `n` slots to the right, leaving `[idx, idx + n)` raw.
+void open_gap(size_type idx, size_type n){ detail::open_gap(ops(), m_storage, m_end, idx, n); }
+
+/// Undoes open_gap(idx, n) when the gap could not be filled.
+void close_gap(size_type idx, size_type n){ detail::close_gap(ops(), m_storage, m_end, idx, n); }
+
+/// Destroys the elements and unmaps the range.
+void release(){
+  destroy(m_storage, m_storage + m_end);
+  if (m_storage != nullptr){ ::munmap(m_storage, m_reserved); }
+  m_storage = nullptr;
+  m_end = m_committed = m_reserved = m_max = 0;
+}
+
+/// Takes over the range of `other`, leaving it without one.
+void steal(vm_vector &other) noexcept {
+  m_storage = std::exchange(other.m_storage, nullptr);
+  m_end = std::exchange(other.m_end, 0);
+  m_committed = std::exchange(other.m_committed, 0);
+  m_reserved = std::exchange(other.m_reserved, 0);
+  m_max = std::exchange(other.m_max, 0);
+}
+
+pointer m_storage{nullptr};  //!< Start of the reserved range.
+size_type m_end{0};          //!< The current size.
+std::size_t m_committed{0};  //!< Bytes of the range that are usable.
+std::size_t m_reserved{0};   //!< Bytes of the reserved range.
+size_type m_max{0};          //!< Elements that fit in the reserved range.
+};
+
+template <typename T, typename G>
+bool operator==(const vm_vector<T, G> &lhs, const vm_vector<T, G> &rhs) {
+  if (lhs.size() != rhs.size()) { return false; }
+  for (typename vm_vector<T, G>::size_type i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) { return false; }
+  }
+  return true;
+}
+
+template <typename T, typename G>
+bool operator!=(const vm_vector<T, G> &lhs, const vm_vector<T, G> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace sc.
+
+#endif
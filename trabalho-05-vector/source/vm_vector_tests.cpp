@@ -0,0 +1,216 @@
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "test_types.h"
+#include "tm/test_manager.h"
+#include "vm_vector.h"
+
+#define YES 1
+#define NO 0
+
+using sc_test::Fragile;
+using sc_test::Moved;
+
+// =============================================================
+// Tests for sc::vm_vector
+// =============================================================
+
+// Growth commits pages in place: data() and element addresses never change.
+#define VM_STABLE_ADDRESSES YES
+// Growth never copies or moves an element.
+#define VM_NO_RELOCATION YES
+// Growing past max_size() throws.
+#define VM_RESERVATION_LIMIT YES
+// shrink_to_fit() decommits the pages past size(); the vector can grow again.
+#define VM_DECOMMIT YES
+// Insert, erase, copy, move and swap.
+#define VM_MODIFIERS YES
+// A moved-from vm_vector can be assigned to again.
+#define VM_REUSE_MOVED YES
+// A throwing copy in insert() leaves the vm_vector as it was.
+#define VM_INSERT_ROLLBACK YES
+
+void run_vm_vector_tests(void) {
+  TestManager tm{"vm_vector testing"};
+
+#if VM_STABLE_ADDRESSES
+  {
+    BEGIN_TEST(tm, "VmStableAddresses", "push_back() over many pages");
+    sc::vm_vector<long> vec;
+    EXPECT_EQ(vec.capacity(), 0u);
+    vec.push_back(0);
+    const long *first = &vec.front();
+    const long *data = vec.data();
+    for (long i{1}; i < 1'000'000; ++i)
+      vec.push_back(i);
+    EXPECT_TRUE(vec.data() == data);
+    EXPECT_TRUE(&vec.front() == first);
+    EXPECT_GE(vec.capacity(), 1'000'000u);
+    EXPECT_EQ(vec[765'432], 765'432);
+    vec.reserve(4'000'000);
+    EXPECT_TRUE(vec.data() == data);
+    EXPECT_EQ(vec.back(), 999'999);
+  }
+#endif
+
+#if VM_NO_RELOCATION
+  {
+    BEGIN_TEST(tm, "VmNoRelocation", "emplace_back() never moves the others");
+    sc::vm_vector<Moved> vec;
+    Moved::transfers = 0;
+    for (int i{0}; i < 100'000; ++i)
+      vec.emplace_back(i);
+    EXPECT_EQ(Moved::transfers, 0);
+    EXPECT_EQ(vec[99'999].value, 99'999);
+  }
+#endif
+
+#if VM_RESERVATION_LIMIT
+  {
+    BEGIN_TEST(tm, "VmReservationLimit", "vm_vector<int>(1000)");
+    sc::vm_vector<int> vec(1000);
+    // The reservation is rounded up to whole pages.
+    EXPECT_GE(vec.max_size(), 1000u);
+    const auto max = vec.max_size();
+    vec.assign(max, 7);
+    EXPECT_EQ(vec.size(), max);
+    EXPECT_TRUE(vec.full());
+
+    bool thrown{false};
+    try {
+      vec.push_back(8);
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(vec.size(), max);
+
+    thrown = false;
+    try {
+      vec.reserve(max + 1);
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+  }
+#endif
+
+#if VM_DECOMMIT
+  {
+    BEGIN_TEST(tm, "VmDecommit", "shrink_to_fit() hands pages back");
+    sc::vm_vector<char> vec;
+    vec.assign(std::size_t{1} << 20, 'x');
+    EXPECT_GE(vec.capacity(), std::size_t{1} << 20);
+    const char *data = vec.data();
+
+    vec.erase(vec.begin() + 10, vec.end());
+    vec.shrink_to_fit();
+    // Only the page holding the remaining elements stays committed.
+    EXPECT_LT(vec.capacity(), std::size_t{1} << 16);
+    EXPECT_GE(vec.capacity(), 10u);
+    EXPECT_EQ(vec.back(), 'x');
+
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 0u);
+    for (int i{0}; i < 100'000; ++i)
+      vec.push_back(char('a' + i % 26));
+    EXPECT_TRUE(vec.data() == data);
+    EXPECT_EQ(vec[27], 'b');
+  }
+#endif
+
+#if VM_MODIFIERS
+  {
+    BEGIN_TEST(tm, "VmModifiers", "insert(), erase(), copy, move, swap");
+    sc::vm_vector<std::string> vec{"c", "d"};
+    vec.push_front("a");
+    vec.insert(vec.begin() + 1, "b");
+    vec.insert(vec.end(), {"e", "f", "g"});
+    EXPECT_EQ(vec, (sc::vm_vector<std::string>{"a", "b", "c", "d", "e", "f", "g"}));
+    vec.erase(vec.begin() + 2, vec.begin() + 4);
+    vec.pop_front();
+    EXPECT_EQ(vec, (sc::vm_vector<std::string>{"b", "e", "f", "g"}));
+    auto it = vec.erase(vec.cbegin() + 1, vec.cbegin() + 1);
+    EXPECT_EQ(it, vec.begin() + 1);
+    EXPECT_EQ(vec, (sc::vm_vector<std::string>{"b", "e", "f", "g"}));
+
+    sc::vm_vector<std::string> copy{vec};
+    EXPECT_EQ(copy, vec);
+    EXPECT_EQ(copy.max_size(), vec.max_size());
+    const auto *data = vec.data();
+    sc::vm_vector<std::string> moved{std::move(vec)};
+    EXPECT_TRUE(moved.data() == data);
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(vec.empty());
+
+    sc::vm_vector<std::string> other{"x"};
+    swap(other, moved);
+    EXPECT_EQ(other, copy);
+    EXPECT_EQ(moved.size(), 1u);
+    moved = other;
+    EXPECT_EQ(moved, copy);
+    vec = std::move(moved);
+    EXPECT_EQ(vec.at(3), "g");
+  }
+#endif
+
+#if VM_REUSE_MOVED
+  {
+    BEGIN_TEST(tm, "VmReuseMoved", "copy assignment and assign() on a moved-from vm_vector");
+    sc::vm_vector<int> source(5000);
+    source.assign({1, 2, 3});
+    sc::vm_vector<int> a{4, 5};
+    sc::vm_vector<int> taken{std::move(a)};
+    a = source;
+    EXPECT_EQ(a, source);
+    EXPECT_EQ(a.max_size(), source.max_size());
+    a.push_back(4);
+    EXPECT_EQ(a.back(), 4);
+
+    sc::vm_vector<int> b{std::move(taken)};
+    taken.assign(std::size_t{3}, 9);
+    EXPECT_EQ(taken, (sc::vm_vector<int>{9, 9, 9}));
+    taken.push_back(10);
+    EXPECT_EQ(taken.size(), 4u);
+    sc::vm_vector<int> c{std::move(b)};
+    b.assign({7, 8});
+    EXPECT_EQ(b, (sc::vm_vector<int>{7, 8}));
+    EXPECT_EQ(c, (sc::vm_vector<int>{4, 5}));
+  }
+#endif
+
+#if VM_INSERT_ROLLBACK
+  {
+    BEGIN_TEST(tm, "VmInsertRollback", "insert(pos, first, last) whose 2nd copy throws");
+    Fragile::alive = 0;
+    {
+      const Fragile source[]{Fragile{100}, Fragile{101}, Fragile{102}};
+      // Gaps narrower and wider than the shifted tail.
+      for (std::size_t at : {1u, 4u}) {
+        sc::vm_vector<Fragile> vec(1000);
+        for (int i{0}; i < 6; ++i)
+          vec.emplace_back(i);
+        Fragile::copies_left = 1;
+        bool thrown{false};
+        try {
+          vec.insert(vec.cbegin() + at, std::begin(source), std::end(source));
+        } catch (const std::runtime_error &) {
+          thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+        EXPECT_EQ(vec.size(), 6u);
+        for (int i{0}; i < 6; ++i)
+          EXPECT_EQ(vec[i].value, i);
+        EXPECT_EQ(Fragile::alive, 3 + 6);
+      }
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}